@@ -0,0 +1,103 @@
+/*
+MIT License
+
+Copyright (c) 2021 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HEAP__ADDRESSABLE_HEAP_H
+#define HEAP__ADDRESSABLE_HEAP_H
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace heap {
+
+  // d-ary heap that hands out a handle for every element pushed, tracking where each element
+  // sits so it can be re-ranked or removed in O(log n). As with Heap, the top is the greatest
+  // element under Compare, and increase_key/decrease_key are meant in that order: with
+  // std::greater, lowering a distance is an increase_key. A handle is released, and may be
+  // handed out again, once its element is popped or erased.
+  template<
+    typename T,
+    typename Compare = std::less<T>,
+    std::size_t Arity = 2>
+  class AddressableHeap {
+    static_assert(Arity >= 2, "a heap node needs at least two children");
+
+   public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using handle_type = std::size_t;
+    using const_reference = T const &;
+
+    AddressableHeap();
+
+    explicit AddressableHeap(Compare const &compare);
+
+    handle_type push(value_type const &value);
+    handle_type push(value_type &&value);
+    template<typename... Args>
+    handle_type emplace(Args &&... args);
+
+    const_reference top() const;
+    handle_type top_handle() const;
+    void pop();
+
+    const_reference value(handle_type handle) const;
+    bool contains(handle_type handle) const;
+
+    // value must not rank below the current one.
+    void increase_key(handle_type handle, value_type value);
+    // value must not rank above the current one.
+    void decrease_key(handle_type handle, value_type value);
+    void update(handle_type handle, value_type value);
+    void erase(handle_type handle);
+
+    size_type size() const;
+    bool empty() const;
+    void clear();
+    void reserve(size_type capacity);
+
+   private:
+    static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+    struct Entry {
+      T value;
+      handle_type handle;
+    };
+
+    Compare compare_;
+    std::vector<Entry> entries_;
+    // Position in entries_ of the element behind each handle, npos for released handles.
+    std::vector<size_type> positions_;
+    std::vector<handle_type> free_handles_;
+
+    handle_type insert(value_type &&value);
+    void remove_at(size_type position);
+    void sift_up(size_type position);
+    void sift_down(size_type position);
+    void place(size_type position, Entry &&entry);
+  };
+
+}  // namespace heap
+#endif
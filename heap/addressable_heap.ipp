@@ -0,0 +1,212 @@
+/*
+MIT License
+
+Copyright (c) 2021 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <heap/addressable_heap.h>
+#include <algorithm>
+#include <utility>
+
+namespace heap {
+
+  template<typename T, typename Compare, std::size_t Arity>
+  AddressableHeap<T, Compare, Arity>::AddressableHeap() = default;
+
+  template<typename T, typename Compare, std::size_t Arity>
+  AddressableHeap<T, Compare, Arity>::AddressableHeap(Compare const &compare) : compare_{compare} {}
+
+  template<typename T, typename Compare, std::size_t Arity>
+  typename AddressableHeap<T, Compare, Arity>::handle_type
+  AddressableHeap<T, Compare, Arity>::push(value_type const &value) {
+    return insert(value_type(value));
+  }
+
+  template<typename T, typename Compare, std::size_t Arity>
+  typename AddressableHeap<T, Compare, Arity>::handle_type
+  AddressableHeap<T, Compare, Arity>::push(value_type &&value) {
+    return insert(std::move(value));
+  }
+
+  template<typename T, typename Compare, std::size_t Arity>
+  template<typename... Args>
+  typename AddressableHeap<T, Compare, Arity>::handle_type
+  AddressableHeap<T, Compare, Arity>::emplace(Args &&... args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  template<typename T, typename Compare, std::size_t Arity>
+  typename AddressableHeap<T, Compare, Arity>::const_reference AddressableHeap<T, Compare, Arity>::top() const {
+    return entries_.front().value;
+  }
+
+  template<typename T, typename Compare, std::size_t Arity>
+  typename AddressableHeap<T, Compare, Arity>::handle_type
+  AddressableHeap<T, Compare, Arity>::top_handle() const {
+    return entries_.front().handle;
+  }
+
+  template<typename T, typename Compare, std::size_t Arity>
+  void AddressableHeap<T, Compare, Arity>::pop() {
+    if (!entries_.empty())
+      remove_at(0);
+  }
+
+  template<typename T, typename Compare, std::size_t Arity>
+  typename AddressableHeap<T, Compare, Arity>::const_reference
+  AddressableHeap<T, Compare, Arity>::value(handle_type handle) const {
+    return entries_[positions_[handle]].value;
+  }
+
+  template<typename T, typename Compare, std::size_t Arity>
+  bool AddressableHeap<T, Compare, Arity>::contains(handle_type handle) const {
+    return handle < positions_.size() && positions_[handle] != npos;
+  }
+
+  template<typename T, typename Compare, std::size_t Arity>
+  void AddressableHeap<T, Compare, Arity>::increase_key(handle_type handle, value_type value) {
+    auto position = positions_[handle];
+    entries_[position].value = std::move(value);
+    sift_up(position);
+  }
+
+  template<typename T, typename Compare, std::size_t Arity>
+  void AddressableHeap<T, Compare, Arity>::decrease_key(handle_type handle, value_type value) {
+    auto position = positions_[handle];
+    entries_[position].value = std::move(value);
+    sift_down(position);
+  }
+
+  template<typename T, typename Compare, std::size_t Arity>
+  void AddressableHeap<T, Compare, Arity>::update(handle_type handle, value_type value) {
+    auto position = positions_[handle];
+    auto raise = compare_(entries_[position].value, value);
+    entries_[position].value = std::move(value);
+    if (raise)
+      sift_up(position);
+    else
+      sift_down(position);
+  }
+
+  template<typename T, typename Compare, std::size_t Arity>
+  void AddressableHeap<T, Compare, Arity>::erase(handle_type handle) {
+    remove_at(positions_[handle]);
+  }
+
+  template<typename T, typename Compare, std::size_t Arity>
+  typename AddressableHeap<T, Compare, Arity>::size_type AddressableHeap<T, Compare, Arity>::size() const {
+    return entries_.size();
+  }
+
+  template<typename T, typename Compare, std::size_t Arity>
+  bool AddressableHeap<T, Compare, Arity>::empty() const {
+    return entries_.empty();
+  }
+
+  template<typename T, typename Compare, std::size_t Arity>
+  void AddressableHeap<T, Compare, Arity>::clear() {
+    entries_.clear();
+    positions_.clear();
+    free_handles_.clear();
+  }
+
+  template<typename T, typename Compare, std::size_t Arity>
+  void AddressableHeap<T, Compare, Arity>::reserve(size_type capacity) {
+    entries_.reserve(capacity);
+    positions_.reserve(capacity);
+  }
+
+  template<typename T, typename Compare, std::size_t Arity>
+  typename AddressableHeap<T, Compare, Arity>::handle_type
+  AddressableHeap<T, Compare, Arity>::insert(value_type &&value) {
+    handle_type handle;
+    if (free_handles_.empty()) {
+      handle = positions_.size();
+      positions_.push_back(entries_.size());
+    } else {
+      handle = free_handles_.back();
+      free_handles_.pop_back();
+      positions_[handle] = entries_.size();
+    }
+    entries_.push_back(Entry{std::move(value), handle});
+    sift_up(entries_.size() - 1);
+    return handle;
+  }
+
+  // The last element fills the hole and moves whichever way it ranks against its new neighbours.
+  template<typename T, typename Compare, std::size_t Arity>
+  void AddressableHeap<T, Compare, Arity>::remove_at(size_type position) {
+    auto handle = entries_[position].handle;
+    positions_[handle] = npos;
+    free_handles_.push_back(handle);
+    auto last = entries_.size() - 1;
+    if (position != last) {
+      auto raise = compare_(entries_[position].value, entries_[last].value);
+      place(position, std::move(entries_[last]));
+      entries_.pop_back();
+      if (raise)
+        sift_up(position);
+      else
+        sift_down(position);
+    } else {
+      entries_.pop_back();
+    }
+  }
+
+  template<typename T, typename Compare, std::size_t Arity>
+  void AddressableHeap<T, Compare, Arity>::sift_up(size_type position) {
+    auto entry = std::move(entries_[position]);
+    while (position > 0) {
+      auto parent = (position - 1) / Arity;
+      if (!compare_(entries_[parent].value, entry.value))
+        break;
+      place(position, std::move(entries_[parent]));
+      position = parent;
+    }
+    place(position, std::move(entry));
+  }
+
+  template<typename T, typename Compare, std::size_t Arity>
+  void AddressableHeap<T, Compare, Arity>::sift_down(size_type position) {
+    auto size = entries_.size();
+    auto entry = std::move(entries_[position]);
+    for (auto child = Arity * position + 1; child < size; child = Arity * position + 1) {
+      auto end = std::min(child + Arity, size);
+      auto best = child;
+      for (++child; child < end; ++child) {
+        if (compare_(entries_[best].value, entries_[child].value))
+          best = child;
+      }
+      if (!compare_(entry.value, entries_[best].value))
+        break;
+      place(position, std::move(entries_[best]));
+      position = best;
+    }
+    place(position, std::move(entry));
+  }
+
+  template<typename T, typename Compare, std::size_t Arity>
+  void AddressableHeap<T, Compare, Arity>::place(size_type position, Entry &&entry) {
+    positions_[entry.handle] = position;
+    entries_[position] = std::move(entry);
+  }
+
+}
@@ -0,0 +1,230 @@
+/*
+MIT License
+
+Copyright (c) 2021 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <heap/addressable_heap.h>
+#include <heap/addressable_heap.ipp>
+#include <heap/heap.h>
+#include <heap/heap.ipp>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace heap::test {
+
+  TEST(AddressableHeap, handles_follow_their_elements) {
+    heap::AddressableHeap<int> h;
+    auto five = h.push(5);
+    auto nine = h.push(9);
+    auto one = h.emplace(1);
+    EXPECT_EQ(h.top(), 9);
+    EXPECT_EQ(h.top_handle(), nine);
+    h.increase_key(one, 12);
+    EXPECT_EQ(h.top_handle(), one);
+    h.decrease_key(one, 0);
+    EXPECT_EQ(h.top_handle(), nine);
+    h.erase(nine);
+    EXPECT_FALSE(h.contains(nine));
+    EXPECT_EQ(h.top_handle(), five);
+    EXPECT_EQ(h.value(one), 0);
+    h.pop();
+    EXPECT_EQ(h.top(), 0);
+    EXPECT_EQ(h.size(), 1);
+  }
+
+  template<std::size_t Arity>
+  void random_operations_match_reference() {
+    std::default_random_engine g(37);
+    std::uniform_int_distribution<int> distribution(-1000, 1000);
+    heap::AddressableHeap<int, std::less<int>, Arity> h;
+    std::map<std::size_t, int> values;
+    std::multiset<int> ranked;
+    auto random_handle = [&]() {
+      return std::next(values.begin(), std::uniform_int_distribution<std::size_t>(0, values.size() - 1)(g))->first;
+    };
+    for (int i = 0; i < 20000; ++i) {
+      auto operation = values.empty() ? 0 : i % 5;
+      auto value = distribution(g);
+      if (operation <= 1) {
+        auto handle = h.push(value);
+        ASSERT_TRUE(values.emplace(handle, value).second);
+        ranked.insert(value);
+      } else if (operation == 4 && i % 2) {
+        ASSERT_EQ(h.top(), *ranked.rbegin());
+        ranked.erase(std::prev(ranked.end()));
+        values.erase(h.top_handle());
+        h.pop();
+      } else {
+        auto handle = random_handle();
+        ranked.erase(ranked.find(values[handle]));
+        if (operation == 4) {
+          h.erase(handle);
+          values.erase(handle);
+          continue;
+        }
+        if (operation == 2)
+          h.update(handle, value);
+        else if (value > values[handle])
+          h.increase_key(handle, value);
+        else
+          h.decrease_key(handle, value);
+        values[handle] = value;
+        ranked.insert(value);
+      }
+      ASSERT_EQ(h.size(), values.size());
+      if (!h.empty()) {
+        ASSERT_EQ(h.top(), *ranked.rbegin());
+        ASSERT_EQ(values[h.top_handle()], h.top());
+      }
+    }
+    for (auto[handle, value] : values)
+      EXPECT_EQ(h.value(handle), value);
+  }
+
+  TEST(AddressableHeap, random_operations_match_reference) {
+    random_operations_match_reference<2>();
+    random_operations_match_reference<4>();
+  }
+
+  struct Graph {
+    std::vector<std::size_t> offsets;
+    std::vector<std::pair<std::size_t, unsigned>> edges;
+  };
+
+  // Grid with random travel times, standing in for a road network.
+  Graph make_grid(std::size_t side) {
+    std::default_random_engine g(41);
+    std::uniform_int_distribution<unsigned> weight(1, 100);
+    Graph graph;
+    for (std::size_t row = 0; row < side; ++row) {
+      for (std::size_t column = 0; column < side; ++column) {
+        graph.offsets.push_back(graph.edges.size());
+        auto vertex = row * side + column;
+        if (row > 0)
+          graph.edges.emplace_back(vertex - side, weight(g));
+        if (row + 1 < side)
+          graph.edges.emplace_back(vertex + side, weight(g));
+        if (column > 0)
+          graph.edges.emplace_back(vertex - 1, weight(g));
+        if (column + 1 < side)
+          graph.edges.emplace_back(vertex + 1, weight(g));
+      }
+    }
+    graph.offsets.push_back(graph.edges.size());
+    return graph;
+  }
+
+  constexpr auto unreachable = std::numeric_limits<unsigned long long>::max();
+
+  // Pushes a fresh entry on every relaxation and skips stale ones when popped.
+  template<std::size_t Arity>
+  std::vector<unsigned long long> lazy_dijkstra(Graph const &graph, std::size_t source) {
+    using Entry = std::pair<unsigned long long, std::size_t>;
+    std::vector<unsigned long long> distances(graph.offsets.size() - 1, unreachable);
+    heap::Heap<Entry, std::vector<Entry>, std::greater<>, Arity> queue{std::greater<>()};
+    distances[source] = 0;
+    queue.push({0, source});
+    while (!queue.empty()) {
+      auto[distance, vertex] = queue.top();
+      queue.pop();
+      if (distance != distances[vertex])
+        continue;
+      for (auto edge = graph.offsets[vertex]; edge < graph.offsets[vertex + 1]; ++edge) {
+        auto[target, weight] = graph.edges[edge];
+        if (distance + weight < distances[target]) {
+          distances[target] = distance + weight;
+          queue.push({distances[target], target});
+        }
+      }
+    }
+    return distances;
+  }
+
+  template<std::size_t Arity>
+  std::vector<unsigned long long> addressable_dijkstra(Graph const &graph, std::size_t source) {
+    using Entry = std::pair<unsigned long long, std::size_t>;
+    using Queue = heap::AddressableHeap<Entry, std::greater<>, Arity>;
+    auto vertices = graph.offsets.size() - 1;
+    std::vector<unsigned long long> distances(vertices, unreachable);
+    std::vector<typename Queue::handle_type> handles(vertices);
+    std::vector<bool> queued(vertices);
+    Queue queue{std::greater<>()};
+    distances[source] = 0;
+    handles[source] = queue.push({0, source});
+    queued[source] = true;
+    while (!queue.empty()) {
+      auto[distance, vertex] = queue.top();
+      queue.pop();
+      queued[vertex] = false;
+      for (auto edge = graph.offsets[vertex]; edge < graph.offsets[vertex + 1]; ++edge) {
+        auto[target, weight] = graph.edges[edge];
+        if (distance + weight < distances[target]) {
+          distances[target] = distance + weight;
+          // A shorter distance ranks higher under std::greater; settled vertices never get here.
+          if (queued[target]) {
+            queue.increase_key(handles[target], {distances[target], target});
+          } else {
+            handles[target] = queue.push({distances[target], target});
+            queued[target] = true;
+          }
+        }
+      }
+    }
+    return distances;
+  }
+
+  TEST(AddressableHeap, dijkstra_matches_lazy_deletion) {
+    auto graph = make_grid(60);
+    EXPECT_EQ(addressable_dijkstra<2>(graph, 0), lazy_dijkstra<2>(graph, 0));
+    EXPECT_EQ(addressable_dijkstra<4>(graph, 1234), lazy_dijkstra<4>(graph, 1234));
+  }
+
+  template<typename Run>
+  double time_run(Run run, std::vector<unsigned long long> &distances) {
+    auto start = std::chrono::steady_clock::now();
+    distances = run();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  TEST(AddressableHeap, benchmark_dijkstra_vs_lazy_deletion) {
+    auto graph = make_grid(1000);
+    std::vector<unsigned long long> lazy;
+    std::vector<unsigned long long> addressable;
+    auto lazy_2 = time_run([&graph] { return lazy_dijkstra<2>(graph, 0); }, lazy);
+    auto addressable_2 = time_run([&graph] { return addressable_dijkstra<2>(graph, 0); }, addressable);
+    EXPECT_EQ(lazy, addressable);
+    auto lazy_4 = time_run([&graph] { return lazy_dijkstra<4>(graph, 0); }, lazy);
+    auto addressable_4 = time_run([&graph] { return addressable_dijkstra<4>(graph, 0); }, addressable);
+    EXPECT_EQ(lazy, addressable);
+    std::cout << "Dijkstra on a 1000x1000 grid: lazy deletion " << lazy_2 << "s (4-ary " << lazy_4
+              << "s), addressable " << addressable_2 << "s (4-ary " << addressable_4 << "s)" << std::endl;
+  }
+
+}
@@ -24,6 +24,8 @@ SOFTWARE.
 #ifndef HEAP__HEAP_H
 #define HEAP__HEAP_H
 
+#include <cstddef>
+#include <functional>
 #include <vector>
 
 namespace heap {
@@ -31,9 +33,13 @@ namespace heap {
   template<
     typename T,
     typename Container = std::vector<T>,
-    typename Compare = std::less<typename Container::value_type>>
+    typename Compare = std::less<typename Container::value_type>,
+    std::size_t Arity = 2>
   class Heap {
+    static_assert(Arity >= 2, "a heap node needs at least two children");
+
    public:
+    using value_type = typename Container::value_type;
     using size_type = typename Container::size_type;
     using const_reference = typename Container::const_reference;
 
@@ -59,6 +65,14 @@ namespace heap {
          Container &&cont = Container());
 
     const_reference top() const;
+    void push(value_type const &value);
+    void push(value_type &&value);
+    template<typename... Args>
+    void emplace(Args &&... args);
+    // Appends a batch, sifting each element up when the batch is small relative to the heap and
+    // rebuilding the whole heap in linear time otherwise.
+    template<class InputIt>
+    void push_range(InputIt first, InputIt last);
     void pop();
     size_type size() const;
     bool empty() const;
@@ -78,11 +92,22 @@ namespace heap {
                         Compare comp);
 
     template<typename RandomAccessIterator>
-    static constexpr RandomAccessIterator left(RandomAccessIterator first, RandomAccessIterator i);
-    template<typename RandomAccessIterator>
-    static constexpr RandomAccessIterator right(RandomAccessIterator first, RandomAccessIterator i);
-    template<typename RandomAccessIterator>
-    static constexpr RandomAccessIterator parent(RandomAccessIterator first, RandomAccessIterator i);
+    static void sift_up(RandomAccessIterator first, RandomAccessIterator i, Compare comp);
+
+    // Moves ancestors of the hole down until value fits there.
+    template<typename RandomAccessIterator, typename Value>
+    static void lift(RandomAccessIterator first, std::ptrdiff_t hole, Value &&value, Compare comp);
+
+    // Floyd's bottom-up sift for a value taken from the bottom of the heap: the larger children
+    // fill the hole at first all the way down to a leaf, with one comparison per level in a
+    // binary heap, and value is lifted back from there, which rarely takes more than a step.
+    template<typename RandomAccessIterator, typename Value>
+    static void replace_top(RandomAccessIterator first, RandomAccessIterator last, Value &&value, Compare comp);
+
+    // The Arity children of a node are adjacent, so scanning them for the largest touches one or
+    // two cache lines while the tree has log(n) / log(Arity) levels.
+    static constexpr std::ptrdiff_t first_child(std::ptrdiff_t i);
+    static constexpr std::ptrdiff_t parent(std::ptrdiff_t i);
 
     Compare compare_;
     Container container_;
@@ -23,58 +23,59 @@ SOFTWARE.
 */
 
 #include <heap/heap.h>
-#include <cmath>
+#include <algorithm>
+#include <bit>
 
 namespace heap {
 
-  template<typename T, typename Container, typename Compare>
-  Heap<T, Container, Compare>::Heap() : size_{0} {
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
+  Heap<T, Container, Compare, Arity>::Heap() : size_{0} {
   }
 
-  template<typename T, typename Container, typename Compare>
-  Heap<T, Container, Compare>::Heap(Compare const &compare) : compare_{compare}, size_{0} {}
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
+  Heap<T, Container, Compare, Arity>::Heap(Compare const &compare) : compare_{compare}, size_{0} {}
 
-  template<typename T, typename Container, typename Compare>
-  Heap<T, Container, Compare>::Heap(Compare const &compare, Container const &cont)
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
+  Heap<T, Container, Compare, Arity>::Heap(Compare const &compare, Container const &cont)
     : compare_{compare}, container_{cont}, size_{container_.size()} {
     make_heap(container_.begin(), container_.end(), compare_);
   }
 
-  template<typename T, typename Container, typename Compare>
-  Heap<T, Container, Compare>::Heap(Compare const &compare, Container &&cont)
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
+  Heap<T, Container, Compare, Arity>::Heap(Compare const &compare, Container &&cont)
     : compare_{compare}, container_{std::move(cont)}, size_{container_.size()} {
     make_heap(container_.begin(), container_.end(), compare_);
   }
 
-  template<typename T, typename Container, typename Compare>
-  Heap<T, Container, Compare>::Heap(Heap const &other)
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
+  Heap<T, Container, Compare, Arity>::Heap(Heap const &other)
     : compare_{other.compare_}, container_{other.container_}, size_{other.size_} {
   }
 
-  template<typename T, typename Container, typename Compare>
-  Heap<T, Container, Compare>::Heap(Heap &&other)
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
+  Heap<T, Container, Compare, Arity>::Heap(Heap &&other)
     : compare_{std::move(other.compare_)},
       container_{std::move(other.container_)},
       size_{other.size_} {
   }
 
-  template<typename T, typename Container, typename Compare>
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
   template<class InputIt>
-  Heap<T, Container, Compare>::Heap(InputIt first,
-                                    InputIt last,
-                                    Compare const &compare,
-                                    Container const &cont)
+  Heap<T, Container, Compare, Arity>::Heap(InputIt first,
+                                           InputIt last,
+                                           Compare const &compare,
+                                           Container const &cont)
     : compare_{compare}, container_{cont}, size_{container_.size() + std::distance(first, last)} {
     container_.insert(container_.end(), first, last);
     make_heap(container_.begin(), container_.end(), compare_);
   }
 
-  template<typename T, typename Container, typename Compare>
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
   template<class InputIt>
-  Heap<T, Container, Compare>::Heap(InputIt first,
-                                    InputIt last,
-                                    Compare const &compare,
-                                    Container &&cont)
+  Heap<T, Container, Compare, Arity>::Heap(InputIt first,
+                                           InputIt last,
+                                           Compare const &compare,
+                                           Container &&cont)
     : compare_{compare},
       container_{std::move(cont)},
       size_{container_.size() + std::distance(first, last)} {
@@ -82,94 +83,176 @@ namespace heap {
     make_heap(container_.begin(), container_.end(), compare_);
   }
 
-  template<typename T, typename Container, typename Compare>
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
   template<typename RandomAccessIterator>
-  void Heap<T, Container, Compare>::make_heap(RandomAccessIterator first,
-                                              RandomAccessIterator last,
-                                              Compare comp) {
-    for (auto i = first + std::floor(std::distance(first, last) / 2) - 1; i >= first; --i) {
-      heapify(i, first, last, comp);
+  void Heap<T, Container, Compare, Arity>::make_heap(RandomAccessIterator first,
+                                                     RandomAccessIterator last,
+                                                     Compare comp) {
+    auto size = std::distance(first, last);
+    for (auto i = (size - 2) / static_cast<decltype(size)>(Arity); size > 1 && i >= 0; --i) {
+      heapify(first + i, first, last, comp);
     }
   }
 
-  template<typename T, typename Container, typename Compare>
+  // Moves a hole down instead of swapping, settling *i below every larger child.
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
   template<typename RandomAccessIterator>
-  void Heap<T, Container, Compare>::heapify(RandomAccessIterator i,
-                                            RandomAccessIterator first,
-                                            RandomAccessIterator last,
-                                            Compare comp) {
-    if (std::distance(i, last) <= 0)
+  void Heap<T, Container, Compare, Arity>::heapify(RandomAccessIterator i,
+                                                   RandomAccessIterator first,
+                                                   RandomAccessIterator last,
+                                                   Compare comp) {
+    auto size = std::distance(first, last);
+    auto hole = std::distance(first, i);
+    if (hole >= size)
       return;
-    auto l = left(first, i);
-    auto r = right(first, i);
-    auto best = i;
-    if (std::distance(l, last) > 0 && comp(*i, *l))
-      best = l;
-    if (std::distance(r, last) > 0 && comp(*best, *r))
-      best = r;
-    if (best != i) {
-      std::swap(*best, *i);
-      heapify(best, first, last, comp);
+    auto value = std::move(first[hole]);
+    for (auto child = first_child(hole); child < size; child = first_child(hole)) {
+      auto end = std::min(child + static_cast<std::ptrdiff_t>(Arity), static_cast<std::ptrdiff_t>(size));
+      auto best = child;
+      for (++child; child < end; ++child) {
+        if (comp(first[best], first[child]))
+          best = child;
+      }
+      if (!comp(value, first[best]))
+        break;
+      first[hole] = std::move(first[best]);
+      hole = best;
     }
+    first[hole] = std::move(value);
   }
 
-  template<typename T, typename Container, typename Compare>
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
   template<typename RandomAccessIterator>
-  constexpr RandomAccessIterator Heap<T, Container, Compare>::left(RandomAccessIterator first,
-                                                                   RandomAccessIterator i) {
-    return first + 2 * std::distance(first, i) + 1;
+  void Heap<T, Container, Compare, Arity>::sift_up(RandomAccessIterator first,
+                                                   RandomAccessIterator i,
+                                                   Compare comp) {
+    lift(first, std::distance(first, i), std::move(*i), comp);
   }
-  template<typename T, typename Container, typename Compare>
-  template<typename RandomAccessIterator>
-  constexpr RandomAccessIterator Heap<T, Container, Compare>::right(RandomAccessIterator first,
-                                                                    RandomAccessIterator i) {
-    return first + 2 * (std::distance(first, i) + 1);
+
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
+  template<typename RandomAccessIterator, typename Value>
+  void Heap<T, Container, Compare, Arity>::lift(RandomAccessIterator first,
+                                                std::ptrdiff_t hole,
+                                                Value &&value,
+                                                Compare comp) {
+    auto lifted = std::move(value);
+    while (hole > 0) {
+      auto p = parent(hole);
+      if (!comp(first[p], lifted))
+        break;
+      first[hole] = std::move(first[p]);
+      hole = p;
+    }
+    first[hole] = std::move(lifted);
   }
 
-  template<typename T, typename Container, typename Compare>
-  template<typename RandomAccessIterator>
-  constexpr RandomAccessIterator Heap<T, Container, Compare>::parent(RandomAccessIterator first,
-                                                                     RandomAccessIterator i) {
-    return (std::distance(first, i) > 0) ? first + std::floor((std::distance(first, i) - 1) / 2)
-                                         : first;
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
+  template<typename RandomAccessIterator, typename Value>
+  void Heap<T, Container, Compare, Arity>::replace_top(RandomAccessIterator first,
+                                                       RandomAccessIterator last,
+                                                       Value &&value,
+                                                       Compare comp) {
+    auto size = std::distance(first, last);
+    std::ptrdiff_t hole = 0;
+    for (auto child = first_child(hole); child < size; child = first_child(hole)) {
+      auto end = std::min(child + static_cast<std::ptrdiff_t>(Arity), static_cast<std::ptrdiff_t>(size));
+      auto best = child;
+      for (++child; child < end; ++child) {
+        if (comp(first[best], first[child]))
+          best = child;
+      }
+      first[hole] = std::move(first[best]);
+      hole = best;
+    }
+    lift(first, hole, std::forward<Value>(value), comp);
+  }
+
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
+  constexpr std::ptrdiff_t Heap<T, Container, Compare, Arity>::first_child(std::ptrdiff_t i) {
+    return static_cast<std::ptrdiff_t>(Arity) * i + 1;
   }
 
-  template<typename T, typename Container, typename Compare>
-  typename Heap<T, Container, Compare>::const_reference Heap<T, Container, Compare>::top() const {
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
+  constexpr std::ptrdiff_t Heap<T, Container, Compare, Arity>::parent(std::ptrdiff_t i) {
+    return (i - 1) / static_cast<std::ptrdiff_t>(Arity);
+  }
+
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
+  typename Heap<T, Container, Compare, Arity>::const_reference Heap<T, Container, Compare, Arity>::top() const {
     return container_.front();
   }
 
-  template<typename T, typename Container, typename Compare>
-  typename Heap<T, Container, Compare>::size_type Heap<T, Container, Compare>::size() const {
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
+  typename Heap<T, Container, Compare, Arity>::size_type Heap<T, Container, Compare, Arity>::size() const {
     return size_;
   }
 
-  template<typename T, typename Container, typename Compare>
-  bool Heap<T, Container, Compare>::empty() const {
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
+  bool Heap<T, Container, Compare, Arity>::empty() const {
     return size() == 0;
   }
 
-  template<typename T, typename Container, typename Compare>
-  void Heap<T, Container, Compare>::pop() {
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
+  void Heap<T, Container, Compare, Arity>::push(value_type const &value) {
+    container_.push_back(value);
+    ++size_;
+    sift_up(container_.begin(), container_.begin() + (size_ - 1), compare_);
+  }
+
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
+  void Heap<T, Container, Compare, Arity>::push(value_type &&value) {
+    container_.push_back(std::move(value));
+    ++size_;
+    sift_up(container_.begin(), container_.begin() + (size_ - 1), compare_);
+  }
+
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
+  template<typename... Args>
+  void Heap<T, Container, Compare, Arity>::emplace(Args &&... args) {
+    container_.emplace_back(std::forward<Args>(args)...);
+    ++size_;
+    sift_up(container_.begin(), container_.begin() + (size_ - 1), compare_);
+  }
+
+  // Sifting count elements up takes up to count * log_Arity(size) moves, while rebuilding
+  // compares about 2 * size times, so a batch switches to rebuilding once it outgrows
+  // size / log_Arity(size).
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
+  template<class InputIt>
+  void Heap<T, Container, Compare, Arity>::push_range(InputIt first, InputIt last) {
+    auto old_size = size_;
+    container_.insert(container_.end(), first, last);
+    size_ = container_.size();
+    auto count = size_ - old_size;
+    auto levels = std::bit_width(size_) / (std::bit_width(Arity) - 1);
+    if (count * levels > 2 * size_) {
+      make_heap(container_.begin(), container_.end(), compare_);
+      return;
+    }
+    for (auto i = old_size; i < size_; ++i)
+      sift_up(container_.begin(), container_.begin() + i, compare_);
+  }
+
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
+  void Heap<T, Container, Compare, Arity>::pop() {
     if (size_ > 0) {
-      container_[0] = std::move(container_[size_ - 1]);
-      --size_;
-      heapify(container_.begin(), container_.begin(), container_.begin() + size_, compare_);
+      auto value = std::move(container_[size_ - 1]);
+      container_.pop_back();
+      if (--size_ > 0)
+        replace_top(container_.begin(), container_.begin() + size_, std::move(value), compare_);
     }
   }
 
-  template<typename T, typename Container, typename Compare>
+  template<typename T, typename Container, typename Compare, std::size_t Arity>
   template<typename RandomAccessIterator>
-  void Heap<T, Container, Compare>::sort(RandomAccessIterator first,
-                                         RandomAccessIterator last,
-                                         Compare comp) {
+  void Heap<T, Container, Compare, Arity>::sort(RandomAccessIterator first,
+                                                RandomAccessIterator last,
+                                                Compare comp) {
     make_heap(first, last, comp);
-    auto size = std::distance(first, last);
-    auto sentinel = last - 1;
-    while (std::distance(first, sentinel) > 0) {
-      std::swap(*first, *sentinel);
-      heapify(first, first, sentinel, comp);
-      --sentinel;
+    for (auto sentinel = last - 1; std::distance(first, sentinel) > 0; --sentinel) {
+      auto value = std::move(*sentinel);
+      *sentinel = std::move(*first);
+      replace_top(first, sentinel, std::move(value), comp);
     }
   }
 
@@ -26,7 +26,13 @@ SOFTWARE.
 #include <gmock/gmock.h>
 #include <heap/heap.h>
 #include <heap/heap.ipp>
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <queue>
 #include <random>
+#include <sstream>
+#include <string>
 
 namespace heap::test {
 
@@ -91,4 +97,207 @@ namespace heap::test {
     }
   }
 
+  TEST(Heap, push_and_pop_match_priority_queue) {
+    std::default_random_engine g(17);
+    std::uniform_int_distribution<int> distribution(-1000, 1000);
+    heap::Heap<int> h;
+    std::priority_queue<int> expected;
+    for (int i = 0; i < 5000; ++i) {
+      if (i % 3 == 2) {
+        h.pop();
+        expected.pop();
+      } else {
+        auto value = distribution(g);
+        if (i % 2)
+          h.push(value);
+        else
+          h.emplace(value);
+        expected.push(value);
+      }
+      ASSERT_EQ(h.size(), expected.size());
+      EXPECT_EQ(h.top(), expected.top());
+    }
+  }
+
+  TEST(Heap, emplace_constructs_in_place) {
+    heap::Heap<std::string> h;
+    h.emplace(3, 'b');
+    h.emplace("c");
+    h.emplace(2, 'a');
+    EXPECT_EQ(h.top(), "c");
+    h.pop();
+    EXPECT_EQ(h.top(), "bbb");
+  }
+
+  template<std::size_t Arity>
+  void push_range_batches_match_sort() {
+    std::default_random_engine g(23);
+    std::uniform_int_distribution<int> distribution(0, 100000);
+    heap::Heap<int, std::vector<int>, std::greater<>, Arity> h;
+    std::vector<int> all;
+    for (std::size_t batch : {1000, 3, 10, 50, 5000, 1, 200}) {
+      std::vector<int> values(batch);
+      for (auto &value : values)
+        value = distribution(g);
+      h.push_range(values.begin(), values.end());
+      all.insert(all.end(), values.begin(), values.end());
+      ASSERT_EQ(h.size(), all.size());
+    }
+    std::sort(all.begin(), all.end());
+    for (auto value : all) {
+      ASSERT_EQ(h.top(), value);
+      h.pop();
+    }
+    EXPECT_TRUE(h.empty());
+  }
+
+  TEST(Heap, push_range_small_and_large_batches) {
+    push_range_batches_match_sort<2>();
+    push_range_batches_match_sort<4>();
+    push_range_batches_match_sort<8>();
+  }
+
+  TEST(Heap, push_range_from_input_iterators) {
+    std::vector<int> v{4, 8};
+    heap::Heap<int> h{std::less<int>(), std::move(v)};
+    std::istringstream input("5 9 1");
+    h.push_range(std::istream_iterator<int>(input), std::istream_iterator<int>());
+    EXPECT_EQ(h.size(), 5);
+    for (int expected : {9, 8, 5, 4, 1}) {
+      EXPECT_EQ(h.top(), expected);
+      h.pop();
+    }
+  }
+
+  template<std::size_t Arity>
+  void random_operations_match_priority_queue() {
+    std::default_random_engine g(29);
+    std::uniform_int_distribution<int> distribution(-1000, 1000);
+    std::vector<int> initial(777);
+    for (auto &value : initial)
+      value = distribution(g);
+    heap::Heap<int, std::vector<int>, std::less<int>, Arity> h{initial.begin(), initial.end()};
+    std::priority_queue<int> expected{initial.begin(), initial.end()};
+    for (int i = 0; i < 3000; ++i) {
+      if (i % 2) {
+        h.pop();
+        expected.pop();
+      } else {
+        auto value = distribution(g);
+        h.push(value);
+        expected.push(value);
+      }
+      ASSERT_EQ(h.top(), expected.top());
+    }
+    std::vector<int> v(initial);
+    heap::Heap<int, std::vector<int>, std::less<int>, Arity>::sort(v.begin(), v.end(), std::less<int>());
+    std::sort(initial.begin(), initial.end());
+    EXPECT_EQ(v, initial);
+  }
+
+  TEST(Heap, arity_3_4_8_match_priority_queue) {
+    random_operations_match_priority_queue<3>();
+    random_operations_match_priority_queue<4>();
+    random_operations_match_priority_queue<8>();
+  }
+
+  template<std::size_t Arity>
+  void benchmark_arity(std::vector<int> const &values) {
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    heap::Heap<int, std::vector<int>, std::greater<>, Arity> built{values.begin(), values.end()};
+    auto make_heap = std::chrono::duration<double>(Clock::now() - start).count();
+
+    heap::Heap<int, std::vector<int>, std::greater<>, Arity> h;
+    start = Clock::now();
+    for (auto value : values)
+      h.push(value);
+    auto push = std::chrono::duration<double>(Clock::now() - start).count();
+
+    long long checksum = 0;
+    start = Clock::now();
+    while (!h.empty()) {
+      checksum += h.top();
+      h.pop();
+    }
+    auto pop = std::chrono::duration<double>(Clock::now() - start).count();
+    EXPECT_EQ(built.top(), *std::min_element(values.begin(), values.end()));
+    std::cout << Arity << "-ary: make_heap " << make_heap << "s, push " << push << "s, pop " << pop
+              << "s (checksum " << checksum << ")" << std::endl;
+  }
+
+  TEST(Heap, benchmark_push_pop_make_heap_by_arity) {
+    std::default_random_engine g(31);
+    std::uniform_int_distribution<int> distribution;
+    std::vector<int> values(4000000);
+    for (auto &value : values)
+      value = distribution(g);
+    benchmark_arity<2>(values);
+    benchmark_arity<4>(values);
+    benchmark_arity<8>(values);
+    benchmark_arity<16>(values);
+  }
+
+  // Key that counts how often it is moved or copied.
+  struct CountedKey {
+    static inline std::size_t moves = 0;
+    int key;
+
+    explicit CountedKey(int k) : key{k} {}
+    CountedKey(CountedKey const &other) : key{other.key} { ++moves; }
+    CountedKey(CountedKey &&other) noexcept : key{other.key} { ++moves; }
+    CountedKey &operator=(CountedKey const &other) {
+      key = other.key;
+      ++moves;
+      return *this;
+    }
+    CountedKey &operator=(CountedKey &&other) noexcept {
+      key = other.key;
+      ++moves;
+      return *this;
+    }
+  };
+
+  struct CountingLess {
+    std::size_t *comparisons;
+    bool operator()(CountedKey const &a, CountedKey const &b) const {
+      ++*comparisons;
+      return a.key < b.key;
+    }
+  };
+
+  TEST(Heap, benchmark_comparisons_and_moves) {
+    std::default_random_engine g(43);
+    std::uniform_int_distribution<int> distribution;
+    std::vector<CountedKey> values;
+    for (int i = 0; i < 1000000; ++i)
+      values.emplace_back(distribution(g));
+    auto report = [&values](std::string const &name, auto run) {
+      std::size_t comparisons = 0;
+      auto v = values;
+      CountedKey::moves = 0;
+      run(v, CountingLess{&comparisons});
+      std::cout << name << ": " << static_cast<double>(comparisons) / values.size() << " comparisons and "
+                << static_cast<double>(CountedKey::moves) / values.size() << " moves per element" << std::endl;
+    };
+    using CountedHeap = heap::Heap<CountedKey, std::vector<CountedKey>, CountingLess>;
+    report("Heap::sort", [](auto &v, CountingLess less) {
+      CountedHeap::sort(v.begin(), v.end(), less);
+      EXPECT_TRUE(std::is_sorted(v.begin(), v.end(), [](auto &a, auto &b) { return a.key < b.key; }));
+    });
+    report("Heap pop all", [](auto &v, CountingLess less) {
+      CountedHeap h{less, std::move(v)};
+      auto previous = h.top().key;
+      while (!h.empty()) {
+        EXPECT_LE(h.top().key, previous);
+        previous = h.top().key;
+        h.pop();
+      }
+    });
+    report("std::make_heap + std::sort_heap", [](auto &v, CountingLess less) {
+      std::make_heap(v.begin(), v.end(), less);
+      std::sort_heap(v.begin(), v.end(), less);
+    });
+  }
+
 }
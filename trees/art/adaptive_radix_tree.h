@@ -0,0 +1,228 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_ART_ADAPTIVE_RADIX_TREE_H_
+#define ALGORITHMS_TREES_ART_ADAPTIVE_RADIX_TREE_H_
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace trees::art {
+
+// Byte strings whose lexicographic order is the order of the keys.
+template<typename Key>
+struct KeyBytes;
+
+// Big endian, so the most significant byte branches first.
+template<std::unsigned_integral Key>
+struct KeyBytes<Key> {
+  static inline std::size_t size(Key) { return sizeof(Key); }
+  static inline std::uint8_t at(Key key, std::size_t index) {
+    return static_cast<std::uint8_t>(key >> (8 * (sizeof(Key) - 1 - index)));
+  }
+};
+
+// Flipping the sign bit puts negative numbers first.
+template<std::signed_integral Key>
+struct KeyBytes<Key> {
+  using Unsigned = std::make_unsigned_t<Key>;
+  static inline std::size_t size(Key) { return sizeof(Key); }
+  static inline std::uint8_t at(Key key, std::size_t index) {
+    auto bits = static_cast<Unsigned>(key) ^ (Unsigned{1} << (8 * sizeof(Key) - 1));
+    return KeyBytes<Unsigned>::at(bits, index);
+  }
+};
+
+template<>
+struct KeyBytes<std::string> {
+  static inline std::size_t size(std::string const &key) { return key.size(); }
+  static inline std::uint8_t at(std::string const &key, std::size_t index) {
+    return static_cast<std::uint8_t>(key[index]);
+  }
+};
+
+// Adaptive radix tree set (Leis et al., ICDE 2013). Keys are split into bytes and each inner node
+// branches on one byte, growing through 4, 16, 48 and 256 slots as children are added. Chains of
+// single-child nodes collapse into a prefix kept in the node below. A lookup touches one node
+// per distinct byte and compares the full key once, at the leaf.
+//
+// A key may be a prefix of another, as strings can; it is then kept in the node where it ends,
+// ordered before that node's children.
+template<typename Key, typename Bytes = KeyBytes<Key>>
+class AdaptiveRadixTree {
+  struct Header;
+  struct Leaf;
+  struct Inner;
+
+ public:
+  using value_type = Key;
+
+  // Prefix bytes kept in a node; longer prefixes are checked against a leaf below the node.
+  static constexpr std::size_t max_prefix = 8;
+
+  AdaptiveRadixTree();
+  AdaptiveRadixTree(AdaptiveRadixTree &&src) noexcept;
+  AdaptiveRadixTree(AdaptiveRadixTree const &) = delete;
+  AdaptiveRadixTree &operator=(AdaptiveRadixTree const &) = delete;
+  ~AdaptiveRadixTree();
+
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Key const;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Key const *;
+    using reference = Key const &;
+
+    const_iterator() = default;
+
+    const_iterator &operator++();
+    const_iterator operator++(int);
+    [[nodiscard]] inline bool operator==(const_iterator const &other) const { return leaf_ == other.leaf_; }
+    [[nodiscard]] inline bool operator!=(const_iterator const &other) const { return leaf_ != other.leaf_; }
+    [[nodiscard]] reference operator*() const;
+    [[nodiscard]] inline pointer operator->() const { return &**this; }
+
+   private:
+    friend class AdaptiveRadixTree;
+
+    // Slot of the child taken in each inner node on the way down, or -1 for its own key.
+    std::vector<std::pair<Inner const *, int>> path_;
+    Leaf const *leaf_ = nullptr;
+
+    void descend(Header const *node);
+  };
+
+  using iterator = const_iterator;
+
+  [[nodiscard]] const_iterator begin() const;
+  [[nodiscard]] inline const_iterator end() const { return const_iterator(); }
+
+  bool insert(value_type value);
+  std::size_t erase(value_type const &value);
+  void clear();
+
+  [[nodiscard]] inline std::size_t size() const { return size_; }
+  [[nodiscard]] inline bool empty() const { return size_ == 0; }
+  [[nodiscard]] bool contains(value_type const &value) const;
+  [[nodiscard]] const_iterator find(value_type const &value) const;
+  [[nodiscard]] const_iterator lower_bound(value_type const &value) const;
+
+  struct NodeCounts {
+    std::size_t leaves;
+    std::size_t node4;
+    std::size_t node16;
+    std::size_t node48;
+    std::size_t node256;
+  };
+  [[nodiscard]] NodeCounts node_counts() const;
+
+ private:
+  enum class Kind : std::uint8_t { leaf, node4, node16, node48, node256 };
+
+  struct Header {
+    Kind kind;
+  };
+
+  struct Leaf : Header {
+    Key key;
+  };
+
+  struct Inner : Header {
+    std::uint16_t count;
+    std::uint32_t prefix_length;
+    std::array<std::uint8_t, max_prefix> prefix;
+    // The key ending at this node, if any.
+    Leaf *terminal;
+  };
+
+  // Node4 and Node16 keep their keys sorted, with the children in the same slots.
+  struct Node4 : Inner {
+    std::array<std::uint8_t, 4> keys;
+    std::array<Header *, 4> children;
+  };
+
+  struct Node16 : Inner {
+    std::array<std::uint8_t, 16> keys;
+    std::array<Header *, 16> children;
+  };
+
+  // index maps a byte to its child slot plus one, zero meaning no child.
+  struct Node48 : Inner {
+    std::array<std::uint8_t, 256> index;
+    std::array<Header *, 48> children;
+  };
+
+  struct Node256 : Inner {
+    std::array<Header *, 256> children;
+  };
+
+  Header *root_;
+  std::size_t size_;
+
+  static Leaf *make_leaf(Key &&key);
+  template<typename NodeType>
+  static NodeType *make_inner(Kind kind, Inner const *header);
+  static void destroy(Header *node);
+  static void count(Header const *node, NodeCounts &counts);
+
+  static inline Inner *inner(Header *node) { return static_cast<Inner *>(node); }
+  static inline Inner const *inner(Header const *node) { return static_cast<Inner const *>(node); }
+  static inline Leaf const *leaf(Header const *node) { return static_cast<Leaf const *>(node); }
+  static bool less(Key const &a, Key const &b);
+  static Leaf const *minimum(Header const *node);
+  static Leaf const *search(Header const *node, Key const &key);
+
+  static Header **find_child(Inner *node, std::uint8_t byte);
+  // First child at slot position or later, with its slot; slots of Node48 and Node256 are bytes.
+  static std::pair<int, Header *> next_child(Inner const *node, int position);
+  // First child whose byte is not less than byte, with its slot.
+  static std::pair<int, Header *> child_at_least(Inner const *node, std::uint8_t byte);
+  static std::uint8_t child_byte(Inner const *node, int position);
+  static void add_child(Header *&ref, std::uint8_t byte, Header *child);
+  // Hangs leaf off the inner node ref, as its own key when the leaf key ends at depth.
+  static void attach(Header *&ref, Leaf *leaf, std::size_t depth);
+  static void remove_child(Header *&ref, std::uint8_t byte);
+  // Replaces a node left with a single entry by that entry; depth is where the node prefix starts.
+  static void collapse(Header *&ref, std::size_t depth);
+
+  // Bytes of the prefix of node, which starts at depth, matching key.
+  static std::size_t prefix_match(Inner const *node, Key const &key, std::size_t depth);
+  static void load_prefix(Inner *node, std::size_t depth);
+
+  bool insert(Header *&ref, Key &key, std::size_t depth);
+  std::size_t erase(Header *&ref, Key const &key, std::size_t depth);
+  // Positions itr on the first key under node not less than key, returning false when there is
+  // none and leaving itr's path as it was.
+  static bool lower_bound(Header const *node, Key const &key, std::size_t depth, const_iterator &itr);
+};
+
+}
+#endif //ALGORITHMS_TREES_ART_ADAPTIVE_RADIX_TREE_H_
@@ -0,0 +1,716 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_ART_ADAPTIVE_RADIX_TREE_IPP_
+#define ALGORITHMS_TREES_ART_ADAPTIVE_RADIX_TREE_IPP_
+
+#include <algorithm>
+#include <bit>
+#include <tuple>
+#include <trees/art/adaptive_radix_tree.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace trees::art {
+
+namespace detail {
+
+// Slot of byte among the first count keys of a Node16, or -1.
+inline int find_byte16(std::uint8_t const *keys, unsigned count, std::uint8_t byte) {
+#if defined(__SSE2__)
+  auto block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(keys));
+  auto matches = _mm_cmpeq_epi8(block, _mm_set1_epi8(static_cast<char>(byte)));
+  auto mask = static_cast<unsigned>(_mm_movemask_epi8(matches)) & ((1u << count) - 1);
+  return mask ? std::countr_zero(mask) : -1;
+#else
+  for (unsigned slot = 0; slot < count; ++slot)
+    if (keys[slot] == byte)
+      return static_cast<int>(slot);
+  return -1;
+#endif
+}
+
+// Slot of the first of the count sorted keys of a Node16 not less than byte, or count.
+inline unsigned lower_bound16(std::uint8_t const *keys, unsigned count, std::uint8_t byte) {
+#if defined(__SSE2__)
+  // SSE2 only compares signed bytes, but key == max(key, byte) holds exactly when key >= byte.
+  auto block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(keys));
+  auto at_least = _mm_cmpeq_epi8(_mm_max_epu8(block, _mm_set1_epi8(static_cast<char>(byte))), block);
+  auto mask = static_cast<unsigned>(_mm_movemask_epi8(at_least)) & ((1u << count) - 1);
+  return mask ? static_cast<unsigned>(std::countr_zero(mask)) : count;
+#else
+  return static_cast<unsigned>(std::lower_bound(keys, keys + count, byte) - keys);
+#endif
+}
+
+}
+
+template<typename Key, typename Bytes>
+AdaptiveRadixTree<Key, Bytes>::AdaptiveRadixTree() : root_{nullptr}, size_{0} {}
+
+template<typename Key, typename Bytes>
+AdaptiveRadixTree<Key, Bytes>::AdaptiveRadixTree(AdaptiveRadixTree &&src) noexcept
+    : root_{std::exchange(src.root_, nullptr)}, size_{std::exchange(src.size_, 0)} {}
+
+template<typename Key, typename Bytes>
+AdaptiveRadixTree<Key, Bytes>::~AdaptiveRadixTree() {
+  destroy(root_);
+}
+
+template<typename Key, typename Bytes>
+void AdaptiveRadixTree<Key, Bytes>::clear() {
+  destroy(root_);
+  root_ = nullptr;
+  size_ = 0;
+}
+
+template<typename Key, typename Bytes>
+typename AdaptiveRadixTree<Key, Bytes>::const_iterator &AdaptiveRadixTree<Key, Bytes>::const_iterator::operator++() {
+  while (!path_.empty()) {
+    auto &[node, position] = path_.back();
+    auto[next, child] = next_child(node, position + 1);
+    if (child) {
+      position = next;
+      descend(child);
+      return *this;
+    }
+    path_.pop_back();
+  }
+  leaf_ = nullptr;
+  return *this;
+}
+
+template<typename Key, typename Bytes>
+typename AdaptiveRadixTree<Key, Bytes>::const_iterator AdaptiveRadixTree<Key, Bytes>::const_iterator::operator++(int) {
+  auto previous = *this;
+  ++*this;
+  return previous;
+}
+
+template<typename Key, typename Bytes>
+typename AdaptiveRadixTree<Key, Bytes>::const_iterator::reference
+AdaptiveRadixTree<Key, Bytes>::const_iterator::operator*() const {
+  return leaf_->key;
+}
+
+template<typename Key, typename Bytes>
+void AdaptiveRadixTree<Key, Bytes>::const_iterator::descend(Header const *node) {
+  while (node->kind != Kind::leaf) {
+    auto parent = inner(node);
+    if (parent->terminal) {
+      path_.emplace_back(parent, -1);
+      leaf_ = parent->terminal;
+      return;
+    }
+    auto[position, child] = next_child(parent, 0);
+    path_.emplace_back(parent, position);
+    node = child;
+  }
+  leaf_ = leaf(node);
+}
+
+template<typename Key, typename Bytes>
+typename AdaptiveRadixTree<Key, Bytes>::const_iterator AdaptiveRadixTree<Key, Bytes>::begin() const {
+  const_iterator itr;
+  if (root_)
+    itr.descend(root_);
+  return itr;
+}
+
+template<typename Key, typename Bytes>
+bool AdaptiveRadixTree<Key, Bytes>::insert(value_type value) {
+  if (!insert(root_, value, 0))
+    return false;
+  ++size_;
+  return true;
+}
+
+template<typename Key, typename Bytes>
+std::size_t AdaptiveRadixTree<Key, Bytes>::erase(value_type const &value) {
+  auto erased = erase(root_, value, 0);
+  size_ -= erased;
+  return erased;
+}
+
+template<typename Key, typename Bytes>
+bool AdaptiveRadixTree<Key, Bytes>::contains(value_type const &value) const {
+  return search(root_, value) != nullptr;
+}
+
+template<typename Key, typename Bytes>
+typename AdaptiveRadixTree<Key, Bytes>::const_iterator AdaptiveRadixTree<Key, Bytes>::find(value_type const &value) const {
+  auto itr = lower_bound(value);
+  if (itr != end() && less(value, *itr))
+    return end();
+  return itr;
+}
+
+template<typename Key, typename Bytes>
+typename AdaptiveRadixTree<Key, Bytes>::const_iterator AdaptiveRadixTree<Key, Bytes>::lower_bound(value_type const &value) const {
+  const_iterator itr;
+  lower_bound(root_, value, 0, itr);
+  return itr;
+}
+
+template<typename Key, typename Bytes>
+typename AdaptiveRadixTree<Key, Bytes>::NodeCounts AdaptiveRadixTree<Key, Bytes>::node_counts() const {
+  NodeCounts counts{};
+  count(root_, counts);
+  return counts;
+}
+
+template<typename Key, typename Bytes>
+typename AdaptiveRadixTree<Key, Bytes>::Leaf *AdaptiveRadixTree<Key, Bytes>::make_leaf(Key &&key) {
+  return new Leaf{{Kind::leaf}, std::move(key)};
+}
+
+template<typename Key, typename Bytes>
+template<typename NodeType>
+NodeType *AdaptiveRadixTree<Key, Bytes>::make_inner(Kind kind, Inner const *header) {
+  auto node = new NodeType{};
+  node->kind = kind;
+  if (header) {
+    node->count = header->count;
+    node->prefix_length = header->prefix_length;
+    node->prefix = header->prefix;
+    node->terminal = header->terminal;
+  }
+  return node;
+}
+
+template<typename Key, typename Bytes>
+void AdaptiveRadixTree<Key, Bytes>::destroy(Header *node) {
+  if (!node)
+    return;
+  if (node->kind == Kind::leaf) {
+    delete static_cast<Leaf *>(node);
+    return;
+  }
+  auto parent = inner(node);
+  destroy(parent->terminal);
+  for (auto[position, child] = next_child(parent, 0); child; std::tie(position, child) = next_child(parent, position + 1))
+    destroy(child);
+  switch (node->kind) {
+    case Kind::node4: delete static_cast<Node4 *>(node);
+      break;
+    case Kind::node16: delete static_cast<Node16 *>(node);
+      break;
+    case Kind::node48: delete static_cast<Node48 *>(node);
+      break;
+    default: delete static_cast<Node256 *>(node);
+      break;
+  }
+}
+
+template<typename Key, typename Bytes>
+void AdaptiveRadixTree<Key, Bytes>::count(Header const *node, NodeCounts &counts) {
+  if (!node)
+    return;
+  switch (node->kind) {
+    case Kind::leaf: ++counts.leaves;
+      return;
+    case Kind::node4: ++counts.node4;
+      break;
+    case Kind::node16: ++counts.node16;
+      break;
+    case Kind::node48: ++counts.node48;
+      break;
+    default: ++counts.node256;
+      break;
+  }
+  auto parent = inner(node);
+  count(parent->terminal, counts);
+  for (auto[position, child] = next_child(parent, 0); child; std::tie(position, child) = next_child(parent, position + 1))
+    count(child, counts);
+}
+
+template<typename Key, typename Bytes>
+bool AdaptiveRadixTree<Key, Bytes>::less(Key const &a, Key const &b) {
+  auto a_size = Bytes::size(a);
+  auto b_size = Bytes::size(b);
+  for (std::size_t index = 0; index < std::min(a_size, b_size); ++index) {
+    auto a_byte = Bytes::at(a, index);
+    auto b_byte = Bytes::at(b, index);
+    if (a_byte != b_byte)
+      return a_byte < b_byte;
+  }
+  return a_size < b_size;
+}
+
+template<typename Key, typename Bytes>
+typename AdaptiveRadixTree<Key, Bytes>::Leaf const *AdaptiveRadixTree<Key, Bytes>::minimum(Header const *node) {
+  while (node->kind != Kind::leaf) {
+    auto parent = inner(node);
+    if (parent->terminal)
+      return parent->terminal;
+    node = next_child(parent, 0).second;
+  }
+  return leaf(node);
+}
+
+// Only the stored prefix bytes are compared on the way down; the leaf settles the rest.
+template<typename Key, typename Bytes>
+typename AdaptiveRadixTree<Key, Bytes>::Leaf const *AdaptiveRadixTree<Key, Bytes>::search(Header const *node, Key const &key) {
+  auto size = Bytes::size(key);
+  std::size_t depth = 0;
+  while (node && node->kind != Kind::leaf) {
+    auto parent = inner(node);
+    if (size < depth + parent->prefix_length)
+      return nullptr;
+    auto stored = std::min<std::size_t>(parent->prefix_length, max_prefix);
+    for (std::size_t index = 0; index < stored; ++index)
+      if (parent->prefix[index] != Bytes::at(key, depth + index))
+        return nullptr;
+    depth += parent->prefix_length;
+    if (depth == size) {
+      node = parent->terminal;
+      break;
+    }
+    auto child = find_child(const_cast<Inner *>(parent), Bytes::at(key, depth++));
+    node = child ? *child : nullptr;
+  }
+  if (!node || !(leaf(node)->key == key))
+    return nullptr;
+  return leaf(node);
+}
+
+template<typename Key, typename Bytes>
+typename AdaptiveRadixTree<Key, Bytes>::Header **AdaptiveRadixTree<Key, Bytes>::find_child(Inner *node, std::uint8_t byte) {
+  switch (node->kind) {
+    case Kind::node4: {
+      auto parent = static_cast<Node4 *>(node);
+      for (unsigned slot = 0; slot < parent->count; ++slot)
+        if (parent->keys[slot] == byte)
+          return &parent->children[slot];
+      return nullptr;
+    }
+    case Kind::node16: {
+      auto parent = static_cast<Node16 *>(node);
+      auto slot = detail::find_byte16(parent->keys.data(), parent->count, byte);
+      return slot < 0 ? nullptr : &parent->children[slot];
+    }
+    case Kind::node48: {
+      auto parent = static_cast<Node48 *>(node);
+      auto slot = parent->index[byte];
+      return slot ? &parent->children[slot - 1] : nullptr;
+    }
+    default: {
+      auto parent = static_cast<Node256 *>(node);
+      return parent->children[byte] ? &parent->children[byte] : nullptr;
+    }
+  }
+}
+
+template<typename Key, typename Bytes>
+std::pair<int, typename AdaptiveRadixTree<Key, Bytes>::Header *>
+AdaptiveRadixTree<Key, Bytes>::next_child(Inner const *node, int position) {
+  switch (node->kind) {
+    case Kind::node4: {
+      auto parent = static_cast<Node4 const *>(node);
+      if (position < parent->count)
+        return {position, parent->children[position]};
+      break;
+    }
+    case Kind::node16: {
+      auto parent = static_cast<Node16 const *>(node);
+      if (position < parent->count)
+        return {position, parent->children[position]};
+      break;
+    }
+    case Kind::node48: {
+      auto parent = static_cast<Node48 const *>(node);
+      for (; position < 256; ++position)
+        if (parent->index[position])
+          return {position, parent->children[parent->index[position] - 1]};
+      break;
+    }
+    default: {
+      auto parent = static_cast<Node256 const *>(node);
+      for (; position < 256; ++position)
+        if (parent->children[position])
+          return {position, parent->children[position]};
+      break;
+    }
+  }
+  return {position, nullptr};
+}
+
+template<typename Key, typename Bytes>
+std::pair<int, typename AdaptiveRadixTree<Key, Bytes>::Header *>
+AdaptiveRadixTree<Key, Bytes>::child_at_least(Inner const *node, std::uint8_t byte) {
+  switch (node->kind) {
+    case Kind::node4: {
+      auto parent = static_cast<Node4 const *>(node);
+      int slot = 0;
+      while (slot < parent->count && parent->keys[slot] < byte)
+        ++slot;
+      return next_child(node, slot);
+    }
+    case Kind::node16: {
+      auto parent = static_cast<Node16 const *>(node);
+      return next_child(node, static_cast<int>(detail::lower_bound16(parent->keys.data(), parent->count, byte)));
+    }
+    default: return next_child(node, byte);
+  }
+}
+
+template<typename Key, typename Bytes>
+std::uint8_t AdaptiveRadixTree<Key, Bytes>::child_byte(Inner const *node, int position) {
+  switch (node->kind) {
+    case Kind::node4: return static_cast<Node4 const *>(node)->keys[position];
+    case Kind::node16: return static_cast<Node16 const *>(node)->keys[position];
+    default: return static_cast<std::uint8_t>(position);
+  }
+}
+
+template<typename Key, typename Bytes>
+void AdaptiveRadixTree<Key, Bytes>::add_child(Header *&ref, std::uint8_t byte, Header *child) {
+  switch (ref->kind) {
+    case Kind::node4: {
+      auto node = static_cast<Node4 *>(ref);
+      if (node->count < 4) {
+        unsigned slot = 0;
+        while (slot < node->count && node->keys[slot] < byte)
+          ++slot;
+        std::copy_backward(node->keys.data() + slot, node->keys.data() + node->count, node->keys.data() + node->count + 1);
+        std::copy_backward(node->children.data() + slot, node->children.data() + node->count, node->children.data() + node->count + 1);
+        node->keys[slot] = byte;
+        node->children[slot] = child;
+        ++node->count;
+        return;
+      }
+      auto grown = make_inner<Node16>(Kind::node16, node);
+      std::copy(node->keys.begin(), node->keys.end(), grown->keys.begin());
+      std::copy(node->children.begin(), node->children.end(), grown->children.begin());
+      delete node;
+      ref = grown;
+      break;
+    }
+    case Kind::node16: {
+      auto node = static_cast<Node16 *>(ref);
+      if (node->count < 16) {
+        auto slot = detail::lower_bound16(node->keys.data(), node->count, byte);
+        std::copy_backward(node->keys.data() + slot, node->keys.data() + node->count, node->keys.data() + node->count + 1);
+        std::copy_backward(node->children.data() + slot, node->children.data() + node->count, node->children.data() + node->count + 1);
+        node->keys[slot] = byte;
+        node->children[slot] = child;
+        ++node->count;
+        return;
+      }
+      auto grown = make_inner<Node48>(Kind::node48, node);
+      for (unsigned slot = 0; slot < 16; ++slot) {
+        grown->index[node->keys[slot]] = static_cast<std::uint8_t>(slot + 1);
+        grown->children[slot] = node->children[slot];
+      }
+      delete node;
+      ref = grown;
+      break;
+    }
+    case Kind::node48: {
+      auto node = static_cast<Node48 *>(ref);
+      if (node->count < 48) {
+        auto slot = std::find(node->children.begin(), node->children.end(), nullptr) - node->children.begin();
+        node->index[byte] = static_cast<std::uint8_t>(slot + 1);
+        node->children[slot] = child;
+        ++node->count;
+        return;
+      }
+      auto grown = make_inner<Node256>(Kind::node256, node);
+      for (unsigned key = 0; key < 256; ++key)
+        if (node->index[key])
+          grown->children[key] = node->children[node->index[key] - 1];
+      delete node;
+      ref = grown;
+      break;
+    }
+    default: {
+      auto node = static_cast<Node256 *>(ref);
+      node->children[byte] = child;
+      ++node->count;
+      return;
+    }
+  }
+  add_child(ref, byte, child);
+}
+
+// Nodes shrink a few children below the size they grew at, so an insert and erase alternating
+// on the boundary do not reallocate every time.
+template<typename Key, typename Bytes>
+void AdaptiveRadixTree<Key, Bytes>::remove_child(Header *&ref, std::uint8_t byte) {
+  switch (ref->kind) {
+    case Kind::node4: {
+      auto node = static_cast<Node4 *>(ref);
+      unsigned slot = 0;
+      while (node->keys[slot] != byte)
+        ++slot;
+      std::copy(node->keys.data() + slot + 1, node->keys.data() + node->count, node->keys.data() + slot);
+      std::copy(node->children.data() + slot + 1, node->children.data() + node->count, node->children.data() + slot);
+      --node->count;
+      break;
+    }
+    case Kind::node16: {
+      auto node = static_cast<Node16 *>(ref);
+      auto slot = static_cast<unsigned>(detail::find_byte16(node->keys.data(), node->count, byte));
+      std::copy(node->keys.data() + slot + 1, node->keys.data() + node->count, node->keys.data() + slot);
+      std::copy(node->children.data() + slot + 1, node->children.data() + node->count, node->children.data() + slot);
+      if (--node->count > 3)
+        break;
+      auto shrunk = make_inner<Node4>(Kind::node4, node);
+      std::copy_n(node->keys.begin(), node->count, shrunk->keys.begin());
+      std::copy_n(node->children.begin(), node->count, shrunk->children.begin());
+      delete node;
+      ref = shrunk;
+      break;
+    }
+    case Kind::node48: {
+      auto node = static_cast<Node48 *>(ref);
+      node->children[node->index[byte] - 1] = nullptr;
+      node->index[byte] = 0;
+      if (--node->count > 12)
+        break;
+      auto shrunk = make_inner<Node16>(Kind::node16, node);
+      unsigned slot = 0;
+      for (unsigned key = 0; key < 256; ++key) {
+        if (node->index[key]) {
+          shrunk->keys[slot] = static_cast<std::uint8_t>(key);
+          shrunk->children[slot++] = node->children[node->index[key] - 1];
+        }
+      }
+      delete node;
+      ref = shrunk;
+      break;
+    }
+    default: {
+      auto node = static_cast<Node256 *>(ref);
+      node->children[byte] = nullptr;
+      if (--node->count > 37)
+        break;
+      auto shrunk = make_inner<Node48>(Kind::node48, node);
+      unsigned slot = 0;
+      for (unsigned key = 0; key < 256; ++key) {
+        if (node->children[key]) {
+          shrunk->index[key] = static_cast<std::uint8_t>(slot + 1);
+          shrunk->children[slot++] = node->children[key];
+        }
+      }
+      delete node;
+      ref = shrunk;
+      break;
+    }
+  }
+}
+
+template<typename Key, typename Bytes>
+void AdaptiveRadixTree<Key, Bytes>::attach(Header *&ref, Leaf *leaf, std::size_t depth) {
+  if (Bytes::size(leaf->key) == depth)
+    inner(ref)->terminal = leaf;
+  else
+    add_child(ref, Bytes::at(leaf->key, depth), leaf);
+}
+
+template<typename Key, typename Bytes>
+void AdaptiveRadixTree<Key, Bytes>::collapse(Header *&ref, std::size_t depth) {
+  if (ref->kind != Kind::node4)
+    return;
+  auto node = static_cast<Node4 *>(ref);
+  if (node->count == 0) {
+    ref = node->terminal;
+  } else if (node->count == 1 && !node->terminal) {
+    ref = node->children[0];
+    if (ref->kind != Kind::leaf) {
+      auto below = inner(ref);
+      below->prefix_length += node->prefix_length + 1;
+      load_prefix(below, depth);
+    }
+  } else {
+    return;
+  }
+  delete node;
+}
+
+template<typename Key, typename Bytes>
+std::size_t AdaptiveRadixTree<Key, Bytes>::prefix_match(Inner const *node, Key const &key, std::size_t depth) {
+  auto length = std::min<std::size_t>(node->prefix_length, Bytes::size(key) - depth);
+  auto stored = std::min(length, max_prefix);
+  std::size_t index = 0;
+  for (; index < stored; ++index)
+    if (node->prefix[index] != Bytes::at(key, depth + index))
+      return index;
+  if (index < length) {
+    auto const &below = minimum(node)->key;
+    for (; index < length; ++index)
+      if (Bytes::at(below, depth + index) != Bytes::at(key, depth + index))
+        return index;
+  }
+  return index;
+}
+
+template<typename Key, typename Bytes>
+void AdaptiveRadixTree<Key, Bytes>::load_prefix(Inner *node, std::size_t depth) {
+  auto const &below = minimum(node)->key;
+  auto stored = std::min<std::size_t>(node->prefix_length, max_prefix);
+  for (std::size_t index = 0; index < stored; ++index)
+    node->prefix[index] = Bytes::at(below, depth + index);
+}
+
+template<typename Key, typename Bytes>
+bool AdaptiveRadixTree<Key, Bytes>::insert(Header *&ref, Key &key, std::size_t depth) {
+  if (!ref) {
+    ref = make_leaf(std::move(key));
+    return true;
+  }
+  if (ref->kind == Kind::leaf) {
+    auto existing = static_cast<Leaf *>(ref);
+    auto limit = std::min(Bytes::size(existing->key), Bytes::size(key));
+    auto common = depth;
+    while (common < limit && Bytes::at(existing->key, common) == Bytes::at(key, common))
+      ++common;
+    if (common == limit && Bytes::size(existing->key) == Bytes::size(key))
+      return false;
+    auto node = make_inner<Node4>(Kind::node4, nullptr);
+    node->prefix_length = static_cast<std::uint32_t>(common - depth);
+    for (std::size_t index = 0; index < std::min<std::size_t>(node->prefix_length, max_prefix); ++index)
+      node->prefix[index] = Bytes::at(key, depth + index);
+    ref = node;
+    attach(ref, existing, common);
+    attach(ref, make_leaf(std::move(key)), common);
+    return true;
+  }
+
+  auto node = inner(ref);
+  auto matched = prefix_match(node, key, depth);
+  if (matched < node->prefix_length) {
+    auto branch = make_inner<Node4>(Kind::node4, nullptr);
+    branch->prefix_length = static_cast<std::uint32_t>(matched);
+    for (std::size_t index = 0; index < std::min(matched, max_prefix); ++index)
+      branch->prefix[index] = Bytes::at(key, depth + index);
+    auto byte = matched < max_prefix ? node->prefix[matched] : Bytes::at(minimum(node)->key, depth + matched);
+    node->prefix_length -= static_cast<std::uint32_t>(matched + 1);
+    load_prefix(node, depth + matched + 1);
+    ref = branch;
+    add_child(ref, byte, node);
+    attach(ref, make_leaf(std::move(key)), depth + matched);
+    return true;
+  }
+
+  depth += node->prefix_length;
+  if (Bytes::size(key) == depth) {
+    if (node->terminal)
+      return false;
+    node->terminal = make_leaf(std::move(key));
+    return true;
+  }
+  auto byte = Bytes::at(key, depth);
+  if (auto child = find_child(node, byte))
+    return insert(*child, key, depth + 1);
+  add_child(ref, byte, make_leaf(std::move(key)));
+  return true;
+}
+
+template<typename Key, typename Bytes>
+std::size_t AdaptiveRadixTree<Key, Bytes>::erase(Header *&ref, Key const &key, std::size_t depth) {
+  if (!ref)
+    return 0;
+  if (ref->kind == Kind::leaf) {
+    auto existing = static_cast<Leaf *>(ref);
+    if (!(existing->key == key))
+      return 0;
+    delete existing;
+    ref = nullptr;
+    return 1;
+  }
+
+  auto node = inner(ref);
+  if (prefix_match(node, key, depth) < node->prefix_length)
+    return 0;
+  auto next = depth + node->prefix_length;
+  if (Bytes::size(key) == next) {
+    if (!node->terminal)
+      return 0;
+    delete node->terminal;
+    node->terminal = nullptr;
+    collapse(ref, depth);
+    return 1;
+  }
+  auto byte = Bytes::at(key, next);
+  auto child = find_child(node, byte);
+  if (!child || !erase(*child, key, next + 1))
+    return 0;
+  if (!*child) {
+    remove_child(ref, byte);
+    collapse(ref, depth);
+  }
+  return 1;
+}
+
+template<typename Key, typename Bytes>
+bool AdaptiveRadixTree<Key, Bytes>::lower_bound(Header const *node, Key const &key, std::size_t depth,
+                                                const_iterator &itr) {
+  if (!node)
+    return false;
+  if (node->kind == Kind::leaf) {
+    if (less(leaf(node)->key, key))
+      return false;
+    itr.leaf_ = leaf(node);
+    return true;
+  }
+
+  auto parent = inner(node);
+  auto matched = prefix_match(parent, key, depth);
+  if (matched < parent->prefix_length) {
+    // Every key below shares the prefix, so they all sort on the same side of key.
+    if (depth + matched < Bytes::size(key)) {
+      auto byte = matched < max_prefix ? parent->prefix[matched] : Bytes::at(minimum(parent)->key, depth + matched);
+      if (byte < Bytes::at(key, depth + matched))
+        return false;
+    }
+    itr.descend(node);
+    return true;
+  }
+
+  depth += parent->prefix_length;
+  if (depth == Bytes::size(key)) {
+    itr.descend(node);
+    return true;
+  }
+  auto byte = Bytes::at(key, depth);
+  auto[position, child] = child_at_least(parent, byte);
+  if (child && child_byte(parent, position) == byte) {
+    itr.path_.emplace_back(parent, position);
+    if (lower_bound(child, key, depth + 1, itr))
+      return true;
+    itr.path_.pop_back();
+    std::tie(position, child) = next_child(parent, position + 1);
+  }
+  if (!child)
+    return false;
+  itr.path_.emplace_back(parent, position);
+  itr.descend(child);
+  return true;
+}
+
+}
+#endif //ALGORITHMS_TREES_ART_ADAPTIVE_RADIX_TREE_IPP_
@@ -0,0 +1,213 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <trees/art/adaptive_radix_tree.h>
+#include <trees/art/adaptive_radix_tree.ipp>
+#include <trees/avl/avl_tree.h>
+#include <trees/avl/avl_tree.ipp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace trees::art::test {
+
+template<typename Key, typename Generate>
+void random_operations_match_set(Generate generate, int operations) {
+  std::default_random_engine generator(59);
+  AdaptiveRadixTree<Key> tree;
+  std::set<Key> expected;
+  for (int i = 0; i < operations; ++i) {
+    auto key = generate(generator);
+    if (i % 3 == 2) {
+      ASSERT_EQ(tree.erase(key), expected.erase(key));
+    } else {
+      ASSERT_EQ(tree.insert(key), expected.insert(key).second);
+    }
+    ASSERT_EQ(tree.size(), expected.size());
+    if (i % 97 == 0) {
+      auto probe = generate(generator);
+      EXPECT_EQ(tree.contains(probe), expected.count(probe) == 1);
+      auto itr = tree.lower_bound(probe);
+      auto expected_itr = expected.lower_bound(probe);
+      ASSERT_EQ(itr == tree.end(), expected_itr == expected.end());
+      if (itr != tree.end()) {
+        EXPECT_EQ(*itr, *expected_itr);
+      }
+    }
+  }
+  EXPECT_TRUE(std::equal(tree.begin(), tree.end(), expected.begin(), expected.end()));
+  for (auto const &key : expected) {
+    EXPECT_TRUE(tree.contains(key));
+    EXPECT_EQ(*tree.find(key), key);
+  }
+}
+
+TEST(AdaptiveRadixTree, random_integers_match_set) {
+  std::uniform_int_distribution<std::uint64_t> dense(0, 3000);
+  random_operations_match_set<std::uint64_t>([&dense](auto &generator) { return dense(generator); }, 30000);
+  std::uniform_int_distribution<std::uint64_t> sparse;
+  random_operations_match_set<std::uint64_t>([&sparse](auto &generator) { return sparse(generator); }, 30000);
+}
+
+TEST(AdaptiveRadixTree, signed_integers_keep_their_order) {
+  AdaptiveRadixTree<int> tree;
+  std::vector<int> keys{5, -1, 0, -300, 1 << 20, -(1 << 20), 42, -42};
+  for (auto key : keys)
+    tree.insert(key);
+  std::sort(keys.begin(), keys.end());
+  EXPECT_TRUE(std::equal(tree.begin(), tree.end(), keys.begin(), keys.end()));
+  EXPECT_EQ(*tree.lower_bound(-41), -1);
+}
+
+// Short alphabet and lengths, so keys are often prefixes of one another and share long prefixes.
+TEST(AdaptiveRadixTree, random_strings_match_set) {
+  std::uniform_int_distribution<int> length(0, 14);
+  std::uniform_int_distribution<int> letter(0, 2);
+  random_operations_match_set<std::string>([&](auto &generator) {
+    std::string key(length(generator) % 3 == 0 ? 12 : 0, 'a');
+    for (int i = length(generator); i > 0; --i)
+      key.push_back(static_cast<char>(letter(generator) == 0 ? '\0' : 'a' + letter(generator)));
+    return key;
+  }, 30000);
+}
+
+TEST(AdaptiveRadixTree, long_prefixes_split_and_merge) {
+  AdaptiveRadixTree<std::string> tree;
+  std::string base(40, 'x');
+  EXPECT_TRUE(tree.insert(base + "1"));
+  EXPECT_TRUE(tree.insert(base + "2"));
+  EXPECT_TRUE(tree.insert(base.substr(0, 20) + "y"));
+  EXPECT_TRUE(tree.insert(base.substr(0, 20)));
+  EXPECT_FALSE(tree.insert(base + "2"));
+  EXPECT_EQ(*tree.lower_bound(base.substr(0, 30)), base + "1");
+  EXPECT_EQ(*tree.lower_bound(base.substr(0, 20) + "x"), base + "1");
+  EXPECT_TRUE(tree.lower_bound(base.substr(0, 20) + "z") == tree.end());
+  EXPECT_EQ(*tree.lower_bound(base + "3"), base.substr(0, 20) + "y");
+
+  EXPECT_EQ(tree.erase(base.substr(0, 20) + "y"), 1);
+  EXPECT_EQ(tree.erase(base.substr(0, 20)), 1);
+  EXPECT_FALSE(tree.contains(base));
+  EXPECT_TRUE(tree.contains(base + "1"));
+  EXPECT_EQ(*tree.lower_bound(base.substr(0, 39) + "w"), base + "1");
+  std::vector<std::string> expected{base + "1", base + "2"};
+  EXPECT_TRUE(std::equal(tree.begin(), tree.end(), expected.begin(), expected.end()));
+}
+
+TEST(AdaptiveRadixTree, nodes_grow_and_shrink) {
+  AdaptiveRadixTree<std::uint32_t> tree;
+  auto fill = [&tree](std::uint32_t children) {
+    tree.clear();
+    for (std::uint32_t key = 0; key < children; ++key)
+      tree.insert(key);
+    return tree.node_counts();
+  };
+  EXPECT_EQ(fill(4).node4, 1);
+  EXPECT_EQ(fill(16).node16, 1);
+  EXPECT_EQ(fill(48).node48, 1);
+  auto counts = fill(256);
+  EXPECT_EQ(counts.node256, 1);
+  EXPECT_EQ(counts.leaves, 256);
+  EXPECT_EQ(counts.node4 + counts.node16 + counts.node48, 0);
+
+  for (std::uint32_t key = 0; key < 250; ++key)
+    tree.erase(key);
+  EXPECT_EQ(tree.node_counts().node16, 1);
+  tree.erase(250);
+  tree.erase(251);
+  tree.erase(252);
+  EXPECT_EQ(tree.node_counts().node4, 1);
+  tree.erase(253);
+  tree.erase(254);
+  counts = tree.node_counts();
+  EXPECT_EQ(counts.leaves, 1);
+  EXPECT_EQ(counts.node4, 0);
+  EXPECT_EQ(*tree.begin(), 255);
+}
+
+template<typename Tree, typename Key>
+double time_lookups(Tree const &tree, std::vector<Key> const &keys, std::size_t &found) {
+  auto start = std::chrono::steady_clock::now();
+  for (auto const &key : keys) {
+    if constexpr (std::is_same_v<Tree, AdaptiveRadixTree<Key>>)
+      found += tree.contains(key);
+    else
+      found += tree.find(key) != tree.end();
+  }
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template<typename Key>
+void benchmark_against_avl(std::string const &name, std::vector<Key> keys) {
+  std::shuffle(keys.begin(), keys.end(), std::default_random_engine(7));
+  AdaptiveRadixTree<Key> art;
+  avl::AVLTree<Key> avl_tree;
+  auto start = std::chrono::steady_clock::now();
+  for (auto const &key : keys)
+    art.insert(key);
+  auto art_insert = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  start = std::chrono::steady_clock::now();
+  for (auto const &key : keys)
+    avl_tree.insert(key);
+  auto avl_insert = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  std::shuffle(keys.begin(), keys.end(), std::default_random_engine(11));
+  std::size_t art_found = 0;
+  std::size_t avl_found = 0;
+  auto art_find = time_lookups(art, keys, art_found);
+  auto avl_find = time_lookups(avl_tree, keys, avl_found);
+  EXPECT_EQ(art_found, keys.size());
+  EXPECT_EQ(avl_found, keys.size());
+  EXPECT_TRUE(std::equal(art.begin(), art.end(), avl_tree.begin(), avl_tree.end()));
+  std::cout << name << ": insert ART " << art_insert << "s, AVLTree " << avl_insert << "s; find ART " << art_find
+            << "s, AVLTree " << avl_find << "s" << std::endl;
+}
+
+TEST(AdaptiveRadixTree, benchmark_dense_integers_vs_avl) {
+  std::vector<std::uint64_t> keys(1000000);
+  std::iota(keys.begin(), keys.end(), std::uint64_t{1} << 40);
+  benchmark_against_avl("dense integers", std::move(keys));
+}
+
+TEST(AdaptiveRadixTree, benchmark_url_strings_vs_avl) {
+  std::vector<std::string> hosts{"https://www.example.com/", "https://docs.example.org/", "http://shop.example.net/"};
+  std::vector<std::string> sections{"products/", "articles/", "users/", "api/v1/items/"};
+  std::default_random_engine generator(13);
+  std::uniform_int_distribution<int> id(0, 9999999);
+  std::set<std::string> unique;
+  while (unique.size() < 300000) {
+    unique.insert(hosts[unique.size() % hosts.size()] + sections[id(generator) % sections.size()]
+                      + std::to_string(id(generator)) + "?ref=home");
+  }
+  benchmark_against_avl("URL strings", std::vector<std::string>(unique.begin(), unique.end()));
+}
+
+}
@@ -0,0 +1,100 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_AVL_AVL_MAP_H_
+#define ALGORITHMS_TREES_AVL_AVL_MAP_H_
+
+#include <functional>
+#include <utility>
+#include <trees/avl/avl_tree.h>
+
+namespace trees::avl {
+
+namespace detail {
+
+// Orders entries by key alone. Being transparent, it lets lookups take a bare key.
+template<typename Key, typename Value, typename Comparator>
+struct MapKeyComparator {
+  using is_transparent = void;
+  using entry_type = std::pair<Key, Value>;
+
+  Comparator comp;
+
+  inline bool operator()(entry_type const &a, entry_type const &b) const { return comp(a.first, b.first); }
+  inline bool operator()(Key const &a, entry_type const &b) const { return comp(a, b.first); }
+  inline bool operator()(entry_type const &a, Key const &b) const { return comp(a.first, b); }
+};
+
+}
+
+// AVLTree of key/value pairs ordered by key. The try_emplace family searches by key first and
+// builds the value in its node only when the key is new, so a payload is constructed exactly once.
+// Erase relinks nodes rather than moving entries, so it is never moved either, and references to
+// the other entries stay valid. Entries are mutable through iterators, but their keys must not be
+// changed.
+template<typename Key,
+         typename Value,
+         typename Comparator = std::less<Key>,
+         typename NodeType = detail::AVLNode<std::pair<Key, Value>>>
+class AVLMap : public AVLTree<std::pair<Key, Value>, detail::MapKeyComparator<Key, Value, Comparator>, NodeType> {
+  using Tree = AVLTree<std::pair<Key, Value>, detail::MapKeyComparator<Key, Value, Comparator>, NodeType>;
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using iterator = typename Tree::iterator;
+  using const_iterator = typename Tree::const_iterator;
+  using value_type = typename Tree::value_type;
+  using Tree::erase;
+
+  inline explicit AVLMap(Comparator const &comp = Comparator())
+      : Tree(detail::MapKeyComparator<Key, Value, Comparator>{comp}) {}
+
+  template<typename... Args>
+  std::pair<iterator, bool> try_emplace(Key const &key, Args &&... args);
+  template<typename... Args>
+  std::pair<iterator, bool> try_emplace(Key &&key, Args &&... args);
+
+  // Assigns value to the entry for key, adding the entry when missing. The bool is true on add.
+  template<typename M>
+  std::pair<iterator, bool> insert_or_assign(Key const &key, M &&value);
+  template<typename M>
+  std::pair<iterator, bool> insert_or_assign(Key &&key, M &&value);
+
+  // Value for key, default constructed in place when missing.
+  Value &operator[](Key const &key);
+  Value &operator[](Key &&key);
+
+  std::size_t erase(Key const &key);
+
+ private:
+  template<typename K, typename... Args>
+  iterator emplace_entry(NodeType *parent, int offset, K &&key, Args &&... args);
+  template<typename K, typename... Args>
+  std::pair<iterator, bool> emplace_key(K &&key, Args &&... args);
+  template<typename K, typename M>
+  std::pair<iterator, bool> assign_key(K &&key, M &&value);
+};
+
+}
+#endif //ALGORITHMS_TREES_AVL_AVL_MAP_H_
@@ -0,0 +1,115 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_AVL_AVL_MAP_IPP_
+#define ALGORITHMS_TREES_AVL_AVL_MAP_IPP_
+
+#include <tuple>
+#include <trees/avl/avl_map.h>
+#include <trees/avl/avl_tree.ipp>
+
+namespace trees::avl {
+
+template<typename Key, typename Value, typename Comparator, typename NodeType>
+template<typename K, typename... Args>
+typename AVLMap<Key, Value, Comparator, NodeType>::iterator
+AVLMap<Key, Value, Comparator, NodeType>::emplace_entry(NodeType *parent, int offset, K &&key, Args &&... args) {
+  return this->emplace_at(parent,
+                          offset,
+                          std::piecewise_construct,
+                          std::forward_as_tuple(std::forward<K>(key)),
+                          std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template<typename Key, typename Value, typename Comparator, typename NodeType>
+template<typename K, typename... Args>
+std::pair<typename AVLMap<Key, Value, Comparator, NodeType>::iterator, bool>
+AVLMap<Key, Value, Comparator, NodeType>::emplace_key(K &&key, Args &&... args) {
+  auto[node, offset] = this->insert_position(key);
+  if (node && offset == 0)
+    return std::make_pair(iterator(node), false);
+  return std::make_pair(emplace_entry(node, offset, std::forward<K>(key), std::forward<Args>(args)...), true);
+}
+
+template<typename Key, typename Value, typename Comparator, typename NodeType>
+template<typename K, typename M>
+std::pair<typename AVLMap<Key, Value, Comparator, NodeType>::iterator, bool>
+AVLMap<Key, Value, Comparator, NodeType>::assign_key(K &&key, M &&value) {
+  auto[node, offset] = this->insert_position(key);
+  if (node && offset == 0) {
+    node->data().second = std::forward<M>(value);
+    return std::make_pair(iterator(node), false);
+  }
+  return std::make_pair(emplace_entry(node, offset, std::forward<K>(key), std::forward<M>(value)), true);
+}
+
+template<typename Key, typename Value, typename Comparator, typename NodeType>
+template<typename... Args>
+std::pair<typename AVLMap<Key, Value, Comparator, NodeType>::iterator, bool>
+AVLMap<Key, Value, Comparator, NodeType>::try_emplace(Key const &key, Args &&... args) {
+  return emplace_key(key, std::forward<Args>(args)...);
+}
+
+template<typename Key, typename Value, typename Comparator, typename NodeType>
+template<typename... Args>
+std::pair<typename AVLMap<Key, Value, Comparator, NodeType>::iterator, bool>
+AVLMap<Key, Value, Comparator, NodeType>::try_emplace(Key &&key, Args &&... args) {
+  return emplace_key(std::move(key), std::forward<Args>(args)...);
+}
+
+template<typename Key, typename Value, typename Comparator, typename NodeType>
+template<typename M>
+std::pair<typename AVLMap<Key, Value, Comparator, NodeType>::iterator, bool>
+AVLMap<Key, Value, Comparator, NodeType>::insert_or_assign(Key const &key, M &&value) {
+  return assign_key(key, std::forward<M>(value));
+}
+
+template<typename Key, typename Value, typename Comparator, typename NodeType>
+template<typename M>
+std::pair<typename AVLMap<Key, Value, Comparator, NodeType>::iterator, bool>
+AVLMap<Key, Value, Comparator, NodeType>::insert_or_assign(Key &&key, M &&value) {
+  return assign_key(std::move(key), std::forward<M>(value));
+}
+
+template<typename Key, typename Value, typename Comparator, typename NodeType>
+Value &AVLMap<Key, Value, Comparator, NodeType>::operator[](Key const &key) {
+  return emplace_key(key).first->second;
+}
+
+template<typename Key, typename Value, typename Comparator, typename NodeType>
+Value &AVLMap<Key, Value, Comparator, NodeType>::operator[](Key &&key) {
+  return emplace_key(std::move(key)).first->second;
+}
+
+template<typename Key, typename Value, typename Comparator, typename NodeType>
+std::size_t AVLMap<Key, Value, Comparator, NodeType>::erase(Key const &key) {
+  auto itr = this->find(key);
+  if (itr == this->end())
+    return 0;
+  erase(itr);
+  return 1;
+}
+
+}
+#endif //ALGORITHMS_TREES_AVL_AVL_MAP_IPP_
@@ -0,0 +1,157 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <trees/avl/avl_map.h>
+#include <trees/avl/avl_map.ipp>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <map>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace trees::avl::test {
+
+namespace {
+
+struct Payload {
+  static inline int constructions = 0;
+
+  int value;
+
+  explicit Payload(int value = 0) : value{value} { ++constructions; }
+  Payload(Payload const &src) : value{src.value} { ++constructions; }
+  Payload(Payload &&src) noexcept: value{src.value} { ++constructions; }
+  Payload &operator=(Payload const &) = default;
+  Payload &operator=(Payload &&) noexcept = default;
+};
+
+// Counts moves and cannot be assigned at all, so erase must leave every other entry where it was
+// built.
+struct Pinned {
+  static inline int moves = 0;
+
+  int value;
+
+  explicit Pinned(int value) : value{value} {}
+  Pinned(Pinned &&src) noexcept: value{src.value} { ++moves; }
+  Pinned &operator=(Pinned const &) = delete;
+};
+
+}
+
+TEST(AVLMap, try_emplace_builds_payload_once) {
+  AVLMap<int, Payload> map;
+  Payload::constructions = 0;
+  for (int key : {5, 3, 8, 1, 4, 7, 9}) {
+    auto[itr, inserted] = map.try_emplace(key, key * 10);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(itr->first, key);
+    EXPECT_EQ(itr->second.value, key * 10);
+  }
+  EXPECT_EQ(Payload::constructions, 7);
+
+  auto[itr, inserted] = map.try_emplace(4, 0);
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(itr->second.value, 40);
+  EXPECT_EQ(Payload::constructions, 7);
+
+  map[2].value = 20;
+  map[2].value += 1;
+  EXPECT_EQ(Payload::constructions, 8);
+  EXPECT_EQ(map.size(), 8);
+  EXPECT_EQ(map.find(2)->second.value, 21);
+}
+
+TEST(AVLMap, insert_or_assign) {
+  AVLMap<std::string, int> map;
+  EXPECT_TRUE(map.insert_or_assign("pear", 1).second);
+  EXPECT_TRUE(map.insert_or_assign("apple", 2).second);
+  auto[itr, inserted] = map.insert_or_assign("pear", 3);
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(itr->second, 3);
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ((*map.begin()).first, "apple");
+  EXPECT_EQ(map.find(std::string("pear"))->second, 3);
+  EXPECT_EQ(map.erase(std::string("pear")), 1);
+  EXPECT_EQ(map.erase(std::string("pear")), 0);
+  EXPECT_EQ(map.find(std::string("pear")), map.end());
+}
+
+TEST(AVLMap, erase_keeps_neighbours_in_place) {
+  AVLMap<int, Pinned> map;
+  Pinned::moves = 0;
+  std::vector<std::pair<int, Pinned> const *> entries;
+  for (int key = 0; key < 300; ++key)
+    entries.push_back(&*map.try_emplace(key, key * 10).first);
+  std::vector<int> keys(300);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::shuffle(keys.begin(), keys.end(), std::default_random_engine(5));
+  for (auto key : keys) {
+    auto itr = map.find(key);
+    auto next = std::next(itr);
+    if (next == map.end())
+      continue;
+    auto const &neighbour = *next;
+    EXPECT_EQ(map.erase(itr), next);
+    EXPECT_EQ(neighbour.second.value, neighbour.first * 10);
+    for (auto const &entry : map)
+      ASSERT_EQ(&entry, entries[entry.first]);
+  }
+  EXPECT_EQ(map.size(), 1);
+  EXPECT_EQ(Pinned::moves, 0);
+}
+
+TEST(AVLMap, random_operations_match_map) {
+  std::default_random_engine generator(17);
+  std::uniform_int_distribution<int> distribution(0, 3000);
+  AVLMap<int, int, std::greater<int>> map;
+  std::map<int, int, std::greater<int>> expected;
+  for (int i = 0; i < 20000; ++i) {
+    auto key = distribution(generator);
+    switch (i % 4) {
+      case 0:
+        EXPECT_EQ(map.try_emplace(key, i).second, expected.try_emplace(key, i).second);
+        break;
+      case 1:
+        EXPECT_EQ(map.insert_or_assign(key, i).second, expected.insert_or_assign(key, i).second);
+        break;
+      case 2:
+        map[key] += i;
+        expected[key] += i;
+        break;
+      default:
+        EXPECT_EQ(map.erase(key), expected.erase(key));
+    }
+    ASSERT_EQ(map.size(), expected.size());
+  }
+  EXPECT_TRUE(std::equal(map.begin(), map.end(), expected.begin(), expected.end(),
+                         [](auto const &a, auto const &b) { return a.first == b.first && a.second == b.second; }));
+  EXPECT_LE(map.height(), 1.44 * std::log2(expected.size() + 2));
+}
+
+}
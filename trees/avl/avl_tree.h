@@ -25,6 +25,7 @@ SOFTWARE.
 #ifndef ALGORITHMS_TREES_AVL_AVLTREE_H_
 #define ALGORITHMS_TREES_AVL_AVLTREE_H_
 
+#include <algorithm>
 #include <memory>
 #include <trees/bst.h>
 
@@ -32,33 +33,48 @@ namespace trees::avl {
 
 namespace detail {
 
-template<typename T>
+template<typename T, template<typename> class Allocator = trees::detail::HeapNodeAllocator>
 struct AVLNodeTraits;
 
 template<typename T, typename NodeTraits = avl::detail::AVLNodeTraits<T>>
 class AVLNode : public trees::detail::BSTNode<T, NodeTraits> {
   using NodeType = typename NodeTraits::NodeType;
  public:
+  using pointer = typename trees::detail::BSTNode<T, NodeTraits>::pointer;
+
   inline explicit AVLNode(T &&data,
                           NodeType *parent = nullptr,
-                          std::unique_ptr<NodeType> left = nullptr,
-                          std::unique_ptr<NodeType> right = nullptr)
+                          pointer left = nullptr,
+                          pointer right = nullptr)
       : trees::detail::BSTNode<T, NodeTraits>(std::forward<T>(data),
                                               parent,
                                               std::move(left),
                                               std::move(right)),
         balance_{0} {}
 
+  template<typename... Args>
+  inline explicit AVLNode(std::in_place_t, NodeType *parent, Args &&... args)
+      : trees::detail::BSTNode<T, NodeTraits>(std::in_place, parent, std::forward<Args>(args)...),
+        balance_{0} {}
+
   inline AVLNode(AVLNode const &src,
-                 AVLNode *parent) : trees::detail::BSTNode<T, NodeTraits>(src, parent),
+                 NodeType *parent) : trees::detail::BSTNode<T, NodeTraits>(src, parent),
                                     balance_{src.balance_} {}
 
   [[nodiscard]] inline char balance() const { return balance_; }
+
+  // Follows the taller child at every step, so only one path is visited.
+  [[nodiscard]] inline std::size_t height() const {
+    std::size_t res = 0;
+    for (auto node = balance() > 0 ? this->right() : this->left(); node; ++res)
+      node = node->balance() > 0 ? node->right() : node->left();
+    return res;
+  }
   inline void balance(char value) {
     balance_ = value;
   }
 
-  [[nodiscard]] inline virtual bool operator==(NodeType const &other) const {
+  [[nodiscard]] inline bool operator==(NodeType const &other) const {
     return trees::detail::BSTNode<T, NodeTraits>::operator==(other)
         && balance() == other.balance();
   }
@@ -66,33 +82,87 @@ class AVLNode : public trees::detail::BSTNode<T, NodeTraits> {
   char balance_;
 };
 
-template<typename T>
+template<typename T, template<typename> class Allocator>
 struct AVLNodeTraits {
   using NodeType = typename trees::avl::detail::AVLNode<T, AVLNodeTraits>;
+  using allocator_type = Allocator<NodeType>;
 };
 
 }
 
-template<typename T, typename Comparator = std::less<T>>
-class AVLTree : public BST<T, Comparator, detail::AVLNode<T>> {
+template<typename T, typename Comparator = std::less<T>, typename NodeType = detail::AVLNode<T>>
+class AVLTree : public BST<T, Comparator, NodeType> {
  public:
-  using iterator = typename BST<T, Comparator, detail::AVLNode<T>>::iterator;
-  using const_iterator = typename BST<T, Comparator, detail::AVLNode<T>>::const_iterator;
-  using value_type = typename BST<T, Comparator, detail::AVLNode<T>>::value_type;
-  using NodeType = typename detail::AVLNode<T>;
-  using BST<T, Comparator, detail::AVLNode<T>>::erase;
+  using iterator = typename BST<T, Comparator, NodeType>::iterator;
+  using const_iterator = typename BST<T, Comparator, NodeType>::const_iterator;
+  using value_type = typename BST<T, Comparator, NodeType>::value_type;
+  using BST<T, Comparator, NodeType>::erase;
 
   explicit AVLTree(Comparator const &comp = Comparator());
-  inline AVLTree(AVLTree &&src) noexcept: BST<T, Comparator, detail::AVLNode<T>>(std::move(src)) {}
-  inline AVLTree(AVLTree const &src) : BST<T, Comparator, detail::AVLNode<T>>(src) {}
+  inline AVLTree(AVLTree &&src) noexcept: BST<T, Comparator, NodeType>(std::move(src)) {}
+  inline AVLTree(AVLTree const &src) : BST<T, Comparator, NodeType>(src) {}
+
+  template<typename ForwardIt>
+  AVLTree(ForwardIt first, ForwardIt last, Comparator const &comp = Comparator());
 
   std::pair<iterator, bool> insert(value_type value) override;
+  iterator insert(const_iterator hint, value_type value) override;
+  // Relinks nodes, so iterators and references to the other elements stay valid.
   iterator erase(const_iterator position) override;
-
-  [[nodiscard]] char balance(const_iterator position);
-  [[nodiscard]] char balance(value_type const &value);
+  // Splits off [first, last) and joins what remains around it, in O(log n + k).
+  iterator erase(const_iterator first, const_iterator last) override;
+
+  // Replaces the contents with [first, last), which must be sorted and free of duplicates. The
+  // tree is built level-balanced in linear time, without comparisons or rotations.
+  template<typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last);
+
+  // Rotations made by insert and erase so far, for comparing balancing schemes.
+  [[nodiscard]] inline std::size_t rotations() const { return rotations_; }
+
+  [[nodiscard]] char balance(const_iterator position) const;
+  [[nodiscard]] char balance(value_type const &value) const;
+
+  // Appends other, whose elements must all order after the ones here, in O(log n).
+  void join(AVLTree other);
+  // Keeps the elements ordered before value and returns the others. Nodes that keep subtree sizes,
+  // like OrderStatisticTree's, make this O(log n); otherwise restoring size() walks the smaller
+  // part, for O(log n + min(k, n - k)) where k elements are kept. The set algebra below splits
+  // detached subtrees and never pays that count.
+  AVLTree split(value_type const &value);
+
+  // Set algebra by recursive split and join: O(m log(n/m + 1)) for sizes m <= n, with the two
+  // recursive halves run on separate threads while the subtrees are large. Elements present in
+  // both trees are kept from this one.
+  void union_with(AVLTree other);
+  void intersect(AVLTree other);
+  void difference(AVLTree other);
+
+ protected:
+  // Builds a node from args in a slot found by insert_position and rebalances above it.
+  template<typename... Args>
+  iterator emplace_at(NodeType *parent, int offset, Args &&... args);
 
  private:
+  using NodePointer = typename BST<T, Comparator, NodeType>::NodePointer;
+
+  // Detached subtree along with its height, which join needs and balance factors alone cannot
+  // give without walking down.
+  struct Subtree {
+    NodePointer root;
+    int height = 0;
+  };
+
+  struct SplitSubtree {
+    Subtree left;
+    NodePointer match;
+    Subtree right;
+  };
+
+  static constexpr int parallel_min_height = 14;
+
+  std::size_t rotations_ = 0;
+
   NodeType *rotate_left(NodeType *subroot, NodeType *right);
   NodeType *rotate_right(NodeType *subroot, NodeType *left);
 
@@ -100,7 +170,41 @@ class AVLTree : public BST<T, Comparator, detail::AVLNode<T>> {
   void update_path_balance_erase(const_iterator position, int child_offset);
   std::pair<bool, NodeType *> update_path_instance_erase(NodeType *parent, NodeType *node);
 
+  template<typename ForwardIt>
+  NodePointer build_sorted(ForwardIt &first, std::size_t count);
+
+  static int subtree_height(NodeType const *node);
+  static inline int left_height(NodeType const *node, int height) {
+    return height - 1 - std::max(0, static_cast<int>(node->balance()));
+  }
+  static inline int right_height(NodeType const *node, int height) {
+    return height - 1 + std::min(0, static_cast<int>(node->balance()));
+  }
+
+  Subtree take_root();
+  void install(Subtree subtree, std::size_t size);
+  [[nodiscard]] int forks() const;
+
+  static Subtree attach(NodePointer node, Subtree left, Subtree right);
+  static Subtree rotate_subtree_left(Subtree subtree);
+  static Subtree rotate_subtree_right(Subtree subtree);
+  static Subtree join_subtrees(Subtree left, NodePointer middle, Subtree right);
+  static Subtree join_right(Subtree left, NodePointer middle, Subtree right);
+  static Subtree join_left(Subtree left, NodePointer middle, Subtree right);
+  static std::pair<Subtree, NodePointer> split_last(Subtree subtree);
+  static Subtree concat(Subtree left, Subtree right);
+  SplitSubtree split_subtree(Subtree subtree, value_type const &value) const;
+
+  Subtree union_subtrees(Subtree first, Subtree second, std::size_t &duplicates, int forks) const;
+  Subtree intersect_subtrees(Subtree first, Subtree second, std::size_t &matches, int forks) const;
+  Subtree difference_subtrees(Subtree first, Subtree second, std::size_t &matches, int forks) const;
+
 };
 
+template<typename T, typename Comparator = std::less<T>>
+using SlabAVLTree = AVLTree<T,
+                            Comparator,
+                            detail::AVLNode<T, detail::AVLNodeTraits<T, trees::detail::SlabNodeAllocator>>>;
+
 }
 #endif //ALGORITHMS_TREES_AVL_AVLTREE_H_
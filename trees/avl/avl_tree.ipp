@@ -25,72 +25,174 @@ SOFTWARE.
 #ifndef ALGORITHMS_TREES_AVL_AVLTREE_IPP_
 #define ALGORITHMS_TREES_AVL_AVLTREE_IPP_
 
+#include <bit>
+#include <future>
+#include <iterator>
+#include <thread>
 #include <trees/avl/avl_tree.h>
 #include <trees/bst.ipp>
 
 namespace trees::avl {
 
-template<typename T, typename Comparator>
-AVLTree<T, Comparator>::AVLTree(Comparator const &comp)
-    : BST<T, Comparator, detail::AVLNode<T>>
-          (comp) {
+namespace detail {
+
+template<typename Left, typename Right>
+inline void fork_join(bool parallel, Left left, Right right) {
+  if (!parallel) {
+    left();
+    right();
+    return;
+  }
+  auto future = std::async(std::launch::async, std::move(left));
+  right();
+  future.get();
 }
 
-template<typename T, typename Comparator>
-std::pair<typename AVLTree<T, Comparator>::iterator, bool>
-AVLTree<T, Comparator>::insert(value_type value) {
-  auto[itr, success] = BST<T,
-                           Comparator,
-                           detail::AVLNode<T>>::insert(std::forward<value_type>(value));
-  update_path_balance_insert(itr);
+}
+
+template<typename T, typename Comparator, typename NodeType>
+AVLTree<T, Comparator, NodeType>::AVLTree(Comparator const &comp)
+    : BST<T, Comparator, NodeType>(comp) {
+}
+
+template<typename T, typename Comparator, typename NodeType>
+template<typename ForwardIt>
+AVLTree<T, Comparator, NodeType>::AVLTree(ForwardIt first, ForwardIt last, Comparator const &comp)
+    : BST<T, Comparator, NodeType>(comp) {
+  assign_sorted(first, last);
+}
+
+template<typename T, typename Comparator, typename NodeType>
+template<typename ForwardIt>
+void AVLTree<T, Comparator, NodeType>::assign_sorted(ForwardIt first, ForwardIt last) {
+  this->clear();
+  auto count = static_cast<std::size_t>(std::distance(first, last));
+  this->root(build_sorted(first, count));
+  this->size(count);
+}
+
+template<typename T, typename Comparator, typename NodeType>
+template<typename ForwardIt>
+typename AVLTree<T, Comparator, NodeType>::NodePointer
+AVLTree<T, Comparator, NodeType>::build_sorted(ForwardIt &first, std::size_t count) {
+  if (count == 0)
+    return nullptr;
+  auto left_count = (count - 1) / 2;
+  auto right_count = count - 1 - left_count;
+  auto left = build_sorted(first, left_count);
+  auto node = this->allocator().make(value_type(*first));
+  ++first;
+  node->left(std::move(left));
+  node->right(build_sorted(first, right_count));
+  // Both halves are complete up to their last level, so their heights are the bit widths.
+  node->balance(static_cast<char>(std::bit_width(right_count) - std::bit_width(left_count)));
+  node->update_augmented();
+  return node;
+}
+
+template<typename T, typename Comparator, typename NodeType>
+std::pair<typename AVLTree<T, Comparator, NodeType>::iterator, bool>
+AVLTree<T, Comparator, NodeType>::insert(value_type value) {
+  auto[itr, success] = BST<T, Comparator, NodeType>::insert(std::move(value), this->root());
+  if (success) {
+    update_path_balance_insert(itr);
+    this->update_path_augmented(this->current(itr));
+  }
   return std::make_pair(itr, success);
 }
 
-template<typename T, typename Comparator>
-typename AVLTree<T, Comparator>::iterator
-AVLTree<T, Comparator>::erase(const_iterator position) {
+template<typename T, typename Comparator, typename NodeType>
+typename AVLTree<T, Comparator, NodeType>::iterator
+AVLTree<T, Comparator, NodeType>::insert(const_iterator hint, value_type value) {
+  auto[itr, success] = this->insert_hinted(hint, std::move(value));
+  if (success) {
+    update_path_balance_insert(itr);
+    this->update_path_augmented(this->current(itr));
+  }
+  return itr;
+}
+
+template<typename T, typename Comparator, typename NodeType>
+template<typename... Args>
+typename AVLTree<T, Comparator, NodeType>::iterator
+AVLTree<T, Comparator, NodeType>::emplace_at(NodeType *parent, int offset, Args &&... args) {
+  auto itr = BST<T, Comparator, NodeType>::emplace_at(parent, offset, std::forward<Args>(args)...);
+  update_path_balance_insert(itr);
+  this->update_path_augmented(this->current(itr));
+  return itr;
+}
+
+// Unlinks the node itself instead of moving a neighbour's value into it, so every other element
+// stays in the node it was built in. A node with two children trades places with its successor,
+// which has no left child and leaves its right child in the slot it vacates.
+template<typename T, typename Comparator, typename NodeType>
+typename AVLTree<T, Comparator, NodeType>::iterator
+AVLTree<T, Comparator, NodeType>::erase(const_iterator position) {
   if (position == this->end())
     return this->end();
   auto node = this->current(position);
-  auto parent = node->parent();
+  auto itr = ++iterator(node);
+  auto size = this->size();
+  // Lowest node whose subtree got shorter, and the side it got shorter on.
+  auto start = node->parent();
+  auto child_offset = start && start->child_is_left(node) ? -1 : 1;
+  NodePointer replacement;
   if (node->left() && node->right()) {
     auto next = node->right()->leftmost();
-    node->data(std::move(next->data_move()));
-    erase(const_iterator(next));
-    return iterator(node);
-  } else if (node->left()) {
-    auto prev = node->left();
-    node->data(std::move(prev->data_move()));
-    erase(const_iterator(prev));
-    return ++iterator(node);
-  } else if (node->right()) {
-    auto next = node->right();
-    node->data(std::move(next->data_move()));
-    erase(const_iterator(next));
-    return iterator(node);
-  } else {
-    auto child_offset = 0;
-    auto itr = ++iterator(node);
-    if (parent && parent->child_is_left(node)) {
-      child_offset = -1;
-      parent->left(nullptr);
-    } else if (parent && parent->child_is_right(node)) {
-      parent->right(nullptr);
+    if (next == node->right()) {
+      replacement = node->right_move();
+      start = next;
       child_offset = 1;
     } else {
-      this->root(nullptr);
+      start = next->parent();
+      child_offset = -1;
+      replacement = start->left_move();
+      start->left(next->right_move());
+      next->right(node->right_move());
     }
-    this->size(this->size() - 1);
-    update_path_balance_erase(const_iterator(parent), child_offset);
-    return itr;
+    next->left(node->left_move());
+    next->balance(node->balance());
+  } else {
+    replacement = node->left() ? node->left_move() : node->right_move();
+  }
+  NodePointer removed;
+  if (node->parent()) {
+    removed = this->move_node_and_replace(node, std::move(replacement));
+  } else {
+    removed = this->root_move();
+    if (replacement)
+      replacement->parent(nullptr);
+    this->root(std::move(replacement));
+  }
+  this->size(size - 1);
+  update_path_balance_erase(const_iterator(start), child_offset);
+  this->update_path_augmented(start);
+  return itr;
+}
+
+template<typename T, typename Comparator, typename NodeType>
+typename AVLTree<T, Comparator, NodeType>::iterator
+AVLTree<T, Comparator, NodeType>::erase(const_iterator first, const_iterator last) {
+  auto last_node = this->current(last);
+  if (first == last)
+    return iterator(last_node);
+  auto size = this->size();
+  auto parts = split_subtree(take_root(), this->current(first)->data());
+  Subtree right;
+  if (last_node) {
+    auto rest = split_subtree(std::move(parts.right), last_node->data());
+    parts.right = std::move(rest.left);
+    right = join_subtrees(Subtree{}, std::move(rest.match), std::move(rest.right));
   }
-  return this->end();
+  auto erased = this->dispose(std::move(parts.match)) + this->dispose(std::move(parts.right.root));
+  install(concat(std::move(parts.left), std::move(right)), size - erased);
+  return iterator(last_node);
 }
 
-template<typename T, typename Comparator>
-std::pair<bool, typename AVLTree<T, Comparator>::NodeType*>
-AVLTree<T, Comparator>::update_path_instance_erase(NodeType *curr,
-                                                   NodeType *child) {
+template<typename T, typename Comparator, typename NodeType>
+std::pair<bool, NodeType*>
+AVLTree<T, Comparator, NodeType>::update_path_instance_erase(NodeType *curr,
+                                                             NodeType *child) {
   if (curr->balance() == 2 && child->balance() >= 0) {
     auto child_balance = child->balance();
     rotate_left(curr, child);
@@ -149,8 +251,8 @@ AVLTree<T, Comparator>::update_path_instance_erase(NodeType *curr,
   return std::make_pair(false, curr);
 }
 
-template<typename T, typename Comparator>
-void AVLTree<T, Comparator>::update_path_balance_insert(const_iterator position) {
+template<typename T, typename Comparator, typename NodeType>
+void AVLTree<T, Comparator, NodeType>::update_path_balance_insert(const_iterator position) {
   if (position == this->end())
     return;
   auto curr = this->current(position);
@@ -219,8 +321,8 @@ void AVLTree<T, Comparator>::update_path_balance_insert(const_iterator position)
   }
 }
 
-template<typename T, typename Comparator>
-void AVLTree<T, Comparator>::update_path_balance_erase(const_iterator position, int child_offset) {
+template<typename T, typename Comparator, typename NodeType>
+void AVLTree<T, Comparator, NodeType>::update_path_balance_erase(const_iterator position, int child_offset) {
   if (position == this->end())
     return;
   auto curr = this->current(position);
@@ -240,37 +342,328 @@ void AVLTree<T, Comparator>::update_path_balance_erase(const_iterator position,
   }
 }
 
-template<typename T, typename Comparator>
-typename AVLTree<T, Comparator>::NodeType *AVLTree<T, Comparator>::rotate_left(NodeType *subroot,
-                                                                               NodeType *right) {
-  std::unique_ptr<NodeType> subroot_right = subroot->right_move();
+template<typename T, typename Comparator, typename NodeType>
+NodeType *AVLTree<T, Comparator, NodeType>::rotate_left(NodeType *subroot,
+                                                        NodeType *right) {
+  ++rotations_;
+  auto subroot_right = subroot->right_move();
   subroot->right(right->left_move());
-  std::unique_ptr<NodeType>
-      subroot_move = this->move_node_and_replace(subroot, std::move(subroot_right));
+  auto subroot_move = this->move_node_and_replace(subroot, std::move(subroot_right));
   right->left(std::move(subroot_move));
+  subroot->update_augmented();
+  right->update_augmented();
   return right;
 }
 
-template<typename T, typename Comparator>
-typename AVLTree<T, Comparator>::NodeType *AVLTree<T, Comparator>::rotate_right(NodeType *subroot,
-                                                                                NodeType *left) {
-  std::unique_ptr<NodeType> subroot_left = subroot->left_move();
+template<typename T, typename Comparator, typename NodeType>
+NodeType *AVLTree<T, Comparator, NodeType>::rotate_right(NodeType *subroot,
+                                                         NodeType *left) {
+  ++rotations_;
+  auto subroot_left = subroot->left_move();
   subroot->left(left->right_move());
-  std::unique_ptr<NodeType>
-      subroot_move = this->move_node_and_replace(subroot, std::move(subroot_left));
+  auto subroot_move = this->move_node_and_replace(subroot, std::move(subroot_left));
   left->right(std::move(subroot_move));
+  subroot->update_augmented();
+  left->update_augmented();
   return left;
 }
 
-template<typename T, typename Comparator>
-char AVLTree<T, Comparator>::balance(const_iterator position) {
+template<typename T, typename Comparator, typename NodeType>
+void AVLTree<T, Comparator, NodeType>::join(AVLTree other) {
+  this->allocator().adopt(other.allocator());
+  auto size = this->size() + other.size();
+  install(concat(take_root(), other.take_root()), size);
+}
+
+template<typename T, typename Comparator, typename NodeType>
+AVLTree<T, Comparator, NodeType> AVLTree<T, Comparator, NodeType>::split(value_type const &value) {
+  AVLTree res{this->comparator()};
+  res.allocator().adopt(this->allocator());
+  auto size = this->size();
+  auto[left, match, right] = split_subtree(take_root(), value);
+  if (match)
+    right = join_subtrees(Subtree{}, std::move(match), std::move(right));
+  install(std::move(left), 0);
+  res.install(std::move(right), 0);
+  if constexpr (NodeType::has_subtree_size) {
+    this->size(this->root() ? this->root()->size() : 0);
+  } else {
+    // Count in lockstep, so only the smaller part is walked.
+    std::size_t count = 0;
+    auto first = this->begin();
+    auto second = res.begin();
+    for (; first != this->end() && second != res.end(); ++first, ++second)
+      ++count;
+    this->size(first == this->end() ? count : size - count);
+  }
+  res.size(size - this->size());
+  return res;
+}
+
+template<typename T, typename Comparator, typename NodeType>
+void AVLTree<T, Comparator, NodeType>::union_with(AVLTree other) {
+  this->allocator().adopt(other.allocator());
+  auto size = this->size() + other.size();
+  std::size_t duplicates = 0;
+  auto res = union_subtrees(take_root(), other.take_root(), duplicates, forks());
+  install(std::move(res), size - duplicates);
+}
+
+template<typename T, typename Comparator, typename NodeType>
+void AVLTree<T, Comparator, NodeType>::intersect(AVLTree other) {
+  this->allocator().adopt(other.allocator());
+  std::size_t matches = 0;
+  auto res = intersect_subtrees(take_root(), other.take_root(), matches, forks());
+  install(std::move(res), matches);
+}
+
+template<typename T, typename Comparator, typename NodeType>
+void AVLTree<T, Comparator, NodeType>::difference(AVLTree other) {
+  this->allocator().adopt(other.allocator());
+  auto size = this->size();
+  std::size_t matches = 0;
+  auto res = difference_subtrees(take_root(), other.take_root(), matches, forks());
+  install(std::move(res), size - matches);
+}
+
+template<typename T, typename Comparator, typename NodeType>
+int AVLTree<T, Comparator, NodeType>::subtree_height(NodeType const *node) {
+  return node ? static_cast<int>(node->height()) + 1 : 0;
+}
+
+template<typename T, typename Comparator, typename NodeType>
+typename AVLTree<T, Comparator, NodeType>::Subtree AVLTree<T, Comparator, NodeType>::take_root() {
+  auto height = subtree_height(this->root());
+  return Subtree{this->root_move(), height};
+}
+
+template<typename T, typename Comparator, typename NodeType>
+void AVLTree<T, Comparator, NodeType>::install(Subtree subtree, std::size_t size) {
+  if (subtree.root)
+    subtree.root->parent(nullptr);
+  this->root(std::move(subtree.root));
+  this->size(size);
+}
+
+// Levels of the recursion that may still fork, enough to keep every core busy. Nodes are only
+// released concurrently when the allocator allows it.
+template<typename T, typename Comparator, typename NodeType>
+int AVLTree<T, Comparator, NodeType>::forks() const {
+  if constexpr (!NodeType::allocator_type::thread_safe)
+    return 0;
+  return std::bit_width(std::thread::hardware_concurrency()) + 1;
+}
+
+
+template<typename T, typename Comparator, typename NodeType>
+typename AVLTree<T, Comparator, NodeType>::Subtree
+AVLTree<T, Comparator, NodeType>::attach(NodePointer node, Subtree left, Subtree right) {
+  node->left(std::move(left.root));
+  node->right(std::move(right.root));
+  node->balance(static_cast<char>(right.height - left.height));
+  node->update_augmented();
+  return Subtree{std::move(node), 1 + std::max(left.height, right.height)};
+}
+
+template<typename T, typename Comparator, typename NodeType>
+typename AVLTree<T, Comparator, NodeType>::Subtree
+AVLTree<T, Comparator, NodeType>::rotate_subtree_left(Subtree subtree) {
+  auto node = std::move(subtree.root);
+  Subtree left{node->left_move(), left_height(node.get(), subtree.height)};
+  auto right_height = AVLTree::right_height(node.get(), subtree.height);
+  auto right = node->right_move();
+  Subtree middle{right->left_move(), left_height(right.get(), right_height)};
+  Subtree outer{right->right_move(), AVLTree::right_height(right.get(), right_height)};
+  auto lower = attach(std::move(node), std::move(left), std::move(middle));
+  return attach(std::move(right), std::move(lower), std::move(outer));
+}
+
+template<typename T, typename Comparator, typename NodeType>
+typename AVLTree<T, Comparator, NodeType>::Subtree
+AVLTree<T, Comparator, NodeType>::rotate_subtree_right(Subtree subtree) {
+  auto node = std::move(subtree.root);
+  Subtree right{node->right_move(), right_height(node.get(), subtree.height)};
+  auto left_height = AVLTree::left_height(node.get(), subtree.height);
+  auto left = node->left_move();
+  Subtree middle{left->right_move(), AVLTree::right_height(left.get(), left_height)};
+  Subtree outer{left->left_move(), AVLTree::left_height(left.get(), left_height)};
+  auto lower = attach(std::move(node), std::move(middle), std::move(right));
+  return attach(std::move(left), std::move(outer), std::move(lower));
+}
+
+template<typename T, typename Comparator, typename NodeType>
+typename AVLTree<T, Comparator, NodeType>::Subtree
+AVLTree<T, Comparator, NodeType>::join_subtrees(Subtree left, NodePointer middle, Subtree right) {
+  if (left.height > right.height + 1)
+    return join_right(std::move(left), std::move(middle), std::move(right));
+  if (right.height > left.height + 1)
+    return join_left(std::move(left), std::move(middle), std::move(right));
+  return attach(std::move(middle), std::move(left), std::move(right));
+}
+
+// Walks down the right spine of the taller left tree to the first subtree no more than one
+// level above right, hangs middle there and rebalances on the way back up.
+template<typename T, typename Comparator, typename NodeType>
+typename AVLTree<T, Comparator, NodeType>::Subtree
+AVLTree<T, Comparator, NodeType>::join_right(Subtree left, NodePointer middle, Subtree right) {
+  auto node = std::move(left.root);
+  Subtree inner{node->left_move(), left_height(node.get(), left.height)};
+  Subtree outer{node->right_move(), right_height(node.get(), left.height)};
+  auto joined = outer.height <= right.height + 1
+                ? attach(std::move(middle), std::move(outer), std::move(right))
+                : join_right(std::move(outer), std::move(middle), std::move(right));
+  if (joined.height <= inner.height + 1)
+    return attach(std::move(node), std::move(inner), std::move(joined));
+  if (joined.root->balance() < 0)
+    joined = rotate_subtree_right(std::move(joined));
+  return rotate_subtree_left(attach(std::move(node), std::move(inner), std::move(joined)));
+}
+
+template<typename T, typename Comparator, typename NodeType>
+typename AVLTree<T, Comparator, NodeType>::Subtree
+AVLTree<T, Comparator, NodeType>::join_left(Subtree left, NodePointer middle, Subtree right) {
+  auto node = std::move(right.root);
+  Subtree inner{node->right_move(), right_height(node.get(), right.height)};
+  Subtree outer{node->left_move(), left_height(node.get(), right.height)};
+  auto joined = outer.height <= left.height + 1
+                ? attach(std::move(middle), std::move(left), std::move(outer))
+                : join_left(std::move(left), std::move(middle), std::move(outer));
+  if (joined.height <= inner.height + 1)
+    return attach(std::move(node), std::move(joined), std::move(inner));
+  if (joined.root->balance() > 0)
+    joined = rotate_subtree_left(std::move(joined));
+  return rotate_subtree_right(attach(std::move(node), std::move(joined), std::move(inner)));
+}
+
+template<typename T, typename Comparator, typename NodeType>
+std::pair<typename AVLTree<T, Comparator, NodeType>::Subtree, typename AVLTree<T, Comparator, NodeType>::NodePointer>
+AVLTree<T, Comparator, NodeType>::split_last(Subtree subtree) {
+  auto node = std::move(subtree.root);
+  Subtree left{node->left_move(), left_height(node.get(), subtree.height)};
+  Subtree right{node->right_move(), right_height(node.get(), subtree.height)};
+  if (!right.root)
+    return std::make_pair(std::move(left), std::move(node));
+  auto[rest, last] = split_last(std::move(right));
+  return std::make_pair(join_subtrees(std::move(left), std::move(node), std::move(rest)), std::move(last));
+}
+
+template<typename T, typename Comparator, typename NodeType>
+typename AVLTree<T, Comparator, NodeType>::Subtree
+AVLTree<T, Comparator, NodeType>::concat(Subtree left, Subtree right) {
+  if (!left.root)
+    return right;
+  if (!right.root)
+    return left;
+  auto[rest, last] = split_last(std::move(left));
+  return join_subtrees(std::move(rest), std::move(last), std::move(right));
+}
+
+template<typename T, typename Comparator, typename NodeType>
+typename AVLTree<T, Comparator, NodeType>::SplitSubtree
+AVLTree<T, Comparator, NodeType>::split_subtree(Subtree subtree, value_type const &value) const {
+  if (!subtree.root)
+    return SplitSubtree{};
+  auto node = std::move(subtree.root);
+  Subtree left{node->left_move(), left_height(node.get(), subtree.height)};
+  Subtree right{node->right_move(), right_height(node.get(), subtree.height)};
+  if (this->comparator()(value, node->data())) {
+    auto res = split_subtree(std::move(left), value);
+    res.right = join_subtrees(std::move(res.right), std::move(node), std::move(right));
+    return res;
+  }
+  if (this->comparator()(node->data(), value)) {
+    auto res = split_subtree(std::move(right), value);
+    res.left = join_subtrees(std::move(left), std::move(node), std::move(res.left));
+    return res;
+  }
+  return SplitSubtree{std::move(left), std::move(node), std::move(right)};
+}
+
+template<typename T, typename Comparator, typename NodeType>
+typename AVLTree<T, Comparator, NodeType>::Subtree
+AVLTree<T, Comparator, NodeType>::union_subtrees(Subtree first,
+                                                 Subtree second,
+                                                 std::size_t &duplicates,
+                                                 int forks) const {
+  if (!first.root)
+    return second;
+  if (!second.root)
+    return first;
+  auto parallel = forks > 0 && std::min(first.height, second.height) >= parallel_min_height;
+  auto node = std::move(first.root);
+  Subtree first_left{node->left_move(), left_height(node.get(), first.height)};
+  Subtree first_right{node->right_move(), right_height(node.get(), first.height)};
+  auto parts = split_subtree(std::move(second), node->data());
+  duplicates += parts.match ? 1 : 0;
+  Subtree left, right;
+  std::size_t left_duplicates = 0, right_duplicates = 0;
+  detail::fork_join(
+      parallel,
+      [&] { left = union_subtrees(std::move(first_left), std::move(parts.left), left_duplicates, forks - 1); },
+      [&] { right = union_subtrees(std::move(first_right), std::move(parts.right), right_duplicates, forks - 1); });
+  duplicates += left_duplicates + right_duplicates;
+  return join_subtrees(std::move(left), std::move(node), std::move(right));
+}
+
+template<typename T, typename Comparator, typename NodeType>
+typename AVLTree<T, Comparator, NodeType>::Subtree
+AVLTree<T, Comparator, NodeType>::intersect_subtrees(Subtree first,
+                                                     Subtree second,
+                                                     std::size_t &matches,
+                                                     int forks) const {
+  if (!first.root || !second.root)
+    return Subtree{};
+  auto parallel = forks > 0 && std::min(first.height, second.height) >= parallel_min_height;
+  auto node = std::move(first.root);
+  Subtree first_left{node->left_move(), left_height(node.get(), first.height)};
+  Subtree first_right{node->right_move(), right_height(node.get(), first.height)};
+  auto parts = split_subtree(std::move(second), node->data());
+  Subtree left, right;
+  std::size_t left_matches = 0, right_matches = 0;
+  detail::fork_join(
+      parallel,
+      [&] { left = intersect_subtrees(std::move(first_left), std::move(parts.left), left_matches, forks - 1); },
+      [&] { right = intersect_subtrees(std::move(first_right), std::move(parts.right), right_matches, forks - 1); });
+  matches += left_matches + right_matches;
+  if (!parts.match)
+    return concat(std::move(left), std::move(right));
+  ++matches;
+  return join_subtrees(std::move(left), std::move(node), std::move(right));
+}
+
+template<typename T, typename Comparator, typename NodeType>
+typename AVLTree<T, Comparator, NodeType>::Subtree
+AVLTree<T, Comparator, NodeType>::difference_subtrees(Subtree first,
+                                                      Subtree second,
+                                                      std::size_t &matches,
+                                                      int forks) const {
+  if (!first.root || !second.root)
+    return first;
+  auto parallel = forks > 0 && std::min(first.height, second.height) >= parallel_min_height;
+  auto node = std::move(second.root);
+  Subtree second_left{node->left_move(), left_height(node.get(), second.height)};
+  Subtree second_right{node->right_move(), right_height(node.get(), second.height)};
+  auto parts = split_subtree(std::move(first), node->data());
+  matches += parts.match ? 1 : 0;
+  Subtree left, right;
+  std::size_t left_matches = 0, right_matches = 0;
+  detail::fork_join(
+      parallel,
+      [&] { left = difference_subtrees(std::move(parts.left), std::move(second_left), left_matches, forks - 1); },
+      [&] { right = difference_subtrees(std::move(parts.right), std::move(second_right), right_matches, forks - 1); });
+  matches += left_matches + right_matches;
+  return concat(std::move(left), std::move(right));
+}
+
+template<typename T, typename Comparator, typename NodeType>
+char AVLTree<T, Comparator, NodeType>::balance(const_iterator position) const {
   if (position == this->end())
     return -3;
   return this->current(position)->balance();
 }
 
-template<typename T, typename Comparator>
-char AVLTree<T, Comparator>::balance(value_type const &value) {
+template<typename T, typename Comparator, typename NodeType>
+char AVLTree<T, Comparator, NodeType>::balance(value_type const &value) const {
   return balance(this->find(value));
 }
 }
@@ -29,6 +29,13 @@ SOFTWARE.
 #include <vector>
 #include <random>
 #include <unordered_set>
+#include <bit>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <algorithm>
+#include <iterator>
+#include <string>
 
 namespace trees::avl::test {
 
@@ -525,4 +532,444 @@ TEST(AVLTree, copy_constructor_and_comparison) {
   EXPECT_EQ(tree, copy_tree);
 }
 
-}
\ No newline at end of file
+TEST(AVLTree, slab_random_insert_and_erase) {
+  auto size = 50000;
+  auto numbers = generate_random_data<unsigned int>(size);
+  SlabAVLTree<unsigned int> avl_tree;
+  std::set<unsigned int> numbers_set;
+  for (std::size_t i = 0; i < numbers.size(); ++i) {
+    avl_tree.insert(numbers[i]);
+    numbers_set.insert(numbers[i]);
+    if (i % 3 == 0) {
+      avl_tree.erase(numbers[i / 2]);
+      numbers_set.erase(numbers[i / 2]);
+    }
+  }
+  ASSERT_EQ(avl_tree.size(), numbers_set.size());
+  std::vector<unsigned int> numbers_from_avl_tree(avl_tree.begin(), avl_tree.end());
+  std::vector<unsigned int> numbers_from_set(numbers_set.begin(), numbers_set.end());
+  EXPECT_EQ(numbers_from_set, numbers_from_avl_tree);
+  EXPECT_LT(avl_tree.height(), 1.44 * std::log2(size));
+  SlabAVLTree<unsigned int> copy_tree{avl_tree};
+  EXPECT_EQ(avl_tree, copy_tree);
+}
+
+TEST(AVLTree, assign_sorted_builds_balanced_tree) {
+  for (int size = 0; size < 130; ++size) {
+    std::vector<int> numbers(size);
+    std::iota(numbers.begin(), numbers.end(), 0);
+    AVLTree<int> tree{numbers.begin(), numbers.end()};
+    ASSERT_EQ(tree.size(), size);
+    std::vector<int> numbers_from_tree(tree.begin(), tree.end());
+    EXPECT_EQ(numbers, numbers_from_tree);
+    if (size > 0) {
+      EXPECT_EQ(tree.height(), std::bit_width(static_cast<unsigned>(size)) - 1);
+    }
+    for (auto number : numbers) {
+      auto balance = tree.balance(number);
+      EXPECT_TRUE(balance == 0 || balance == 1);
+    }
+  }
+}
+
+TEST(AVLTree, assign_sorted_then_insert_and_erase) {
+  auto size = 20000;
+  auto numbers = generate_random_data<unsigned int>(size);
+  std::set<unsigned int> numbers_set(numbers.begin(), numbers.begin() + size / 2);
+  AVLTree<unsigned int> avl_tree;
+  avl_tree.insert(7);
+  avl_tree.assign_sorted(numbers_set.begin(), numbers_set.end());
+  for (int i = size / 2; i < size; ++i) {
+    avl_tree.insert(numbers[i]);
+    numbers_set.insert(numbers[i]);
+    avl_tree.erase(numbers[i - size / 2]);
+    numbers_set.erase(numbers[i - size / 2]);
+  }
+  ASSERT_EQ(avl_tree.size(), numbers_set.size());
+  std::vector<unsigned int> numbers_from_avl_tree(avl_tree.begin(), avl_tree.end());
+  std::vector<unsigned int> numbers_from_set(numbers_set.begin(), numbers_set.end());
+  EXPECT_EQ(numbers_from_set, numbers_from_avl_tree);
+  EXPECT_LT(avl_tree.height(), 1.44 * std::log2(size));
+}
+
+TEST(AVLTree, random_range_matches_set) {
+  auto size = 20000;
+  auto numbers = generate_random_data<unsigned int>(size);
+  AVLTree<unsigned int> avl_tree;
+  std::set<unsigned int> numbers_set(numbers.begin(), numbers.end());
+  for (auto number : numbers)
+    avl_tree.insert(number);
+  for (int i = 0; i + 1 < size; i += 97) {
+    auto first = std::min(numbers[i], numbers[i + 1]);
+    auto last = std::max(numbers[i], numbers[i + 1]);
+    auto values = avl_tree.range(first, last);
+    std::vector<unsigned int> from_tree(values.begin(), values.end());
+    std::vector<unsigned int> from_set(numbers_set.lower_bound(first), numbers_set.lower_bound(last));
+    ASSERT_EQ(from_set, from_tree);
+    EXPECT_EQ(*avl_tree.upper_bound(first), *numbers_set.upper_bound(first));
+  }
+}
+
+// Recomputes every balance factor from node levels instead of trusting the stored ones. In order,
+// a node's left subtree is the run of deeper nodes just before it and its right subtree the run
+// just after, so their heights are the deepest levels in those runs.
+template<typename Tree>
+void expect_valid_avl(Tree const &tree, std::set<unsigned int> const &expected) {
+  ASSERT_EQ(tree.size(), expected.size());
+  EXPECT_TRUE(std::equal(tree.begin(), tree.end(), expected.begin(), expected.end()));
+  if (expected.empty())
+    return;
+  EXPECT_LE(tree.height(), 1.44 * std::log2(expected.size() + 2));
+  std::vector<std::size_t> levels;
+  for (auto itr = tree.begin(); itr != tree.end(); ++itr)
+    levels.push_back(tree.level(itr));
+  EXPECT_EQ(tree.height(), *std::max_element(levels.begin(), levels.end()));
+  auto itr = tree.begin();
+  for (std::size_t i = 0; i < levels.size(); ++i, ++itr) {
+    std::size_t left_height = 0;
+    for (auto j = i; j > 0 && levels[j - 1] > levels[i]; --j)
+      left_height = std::max(left_height, levels[j - 1] - levels[i]);
+    std::size_t right_height = 0;
+    for (auto j = i + 1; j < levels.size() && levels[j] > levels[i]; ++j)
+      right_height = std::max(right_height, levels[j] - levels[i]);
+    auto balance = static_cast<int>(right_height) - static_cast<int>(left_height);
+    ASSERT_TRUE(balance >= -1 && balance <= 1);
+    ASSERT_EQ(static_cast<int>(tree.balance(itr)), balance);
+  }
+}
+
+TEST(AVLTree, height_follows_one_path) {
+  std::default_random_engine generator(23);
+  std::uniform_int_distribution<int> distribution(0, 3000);
+  AVLTree<int> tree;
+  for (int i = 0; i < 6000; ++i) {
+    auto number = distribution(generator);
+    if (i % 3 == 2)
+      tree.erase(number);
+    else
+      tree.insert(number);
+    if (i % 500 == 0 || i == 5999) {
+      std::size_t max_level = 0;
+      for (auto itr = tree.begin(); itr != tree.end(); ++itr)
+        max_level = std::max(max_level, tree.level(itr));
+      ASSERT_EQ(tree.height(), max_level);
+      EXPECT_EQ(tree.shape().height, max_level);
+    }
+  }
+}
+
+TEST(AVLTree, hinted_insert_matches_set) {
+  std::default_random_engine generator(29);
+  std::uniform_int_distribution<int> distribution(0, 5000);
+  AVLTree<int> tree;
+  std::set<int> numbers_set;
+  auto hint = tree.end();
+  for (int i = 0; i < 10000; ++i) {
+    auto number = i % 5 == 0 ? distribution(generator) : i;
+    switch (i % 3) {
+      case 0: hint = tree.insert(hint, number); break;
+      case 1: hint = tree.insert(tree.end(), number); break;
+      default: hint = tree.emplace_hint(tree.lower_bound(number), number); break;
+    }
+    numbers_set.insert(number);
+    ASSERT_EQ(*hint, number);
+    ASSERT_EQ(tree.size(), numbers_set.size());
+  }
+  std::set<unsigned int> expected(numbers_set.begin(), numbers_set.end());
+  AVLTree<unsigned int> unsigned_tree;
+  for (auto number : numbers_set)
+    unsigned_tree.insert(unsigned_tree.begin(), number);
+  expect_valid_avl(unsigned_tree, expected);
+  EXPECT_TRUE(std::equal(tree.begin(), tree.end(), numbers_set.begin(), numbers_set.end()));
+  for (auto itr = tree.begin(); itr != tree.end(); ++itr) {
+    auto balance = tree.balance(itr);
+    ASSERT_TRUE(balance >= -1 && balance <= 1);
+  }
+}
+
+// The cached first and last nodes must follow erase, split and join, or hints at the ends would
+// attach to freed or foreign nodes.
+TEST(AVLTree, hinted_insert_at_the_ends_after_reshaping) {
+  AVLTree<int> tree;
+  std::set<int> expected;
+  auto insert_ends = [&](int low, int high) {
+    tree.insert(tree.end(), high);
+    tree.insert(tree.begin(), low);
+    expected.insert(high);
+    expected.insert(low);
+  };
+  for (int i = 0; i < 100; ++i)
+    insert_ends(-i, i + 100);
+  tree.erase(-99);
+  tree.erase(199);
+  expected.erase(-99);
+  expected.erase(199);
+  insert_ends(-1000, 1000);
+  auto upper = tree.split(150);
+  expected.erase(expected.lower_bound(150), expected.end());
+  insert_ends(-2000, 149);
+  upper.insert(upper.end(), 5000);
+  tree.join(std::move(upper));
+  for (int i = 150; i < 199; ++i)
+    expected.insert(i);
+  expected.insert(1000);
+  expected.insert(5000);
+  insert_ends(-3000, 6000);
+  tree.erase(tree.begin(), std::next(tree.begin(), 10));
+  expected.erase(expected.begin(), std::next(expected.begin(), 10));
+  insert_ends(-4000, 7000);
+  EXPECT_TRUE(std::equal(tree.begin(), tree.end(), expected.begin(), expected.end()));
+  for (auto itr = tree.begin(); itr != tree.end(); ++itr) {
+    auto balance = tree.balance(itr);
+    ASSERT_TRUE(balance >= -1 && balance <= 1);
+  }
+  tree.clear();
+  tree.insert(tree.end(), 1);
+  tree.insert(tree.begin(), 0);
+  tree.insert(tree.end(), 2);
+  EXPECT_THAT(std::vector<int>(tree.begin(), tree.end()), ::testing::ElementsAre(0, 1, 2));
+}
+
+// Times plain insert against insert(end()) and insert(previous) over numbers, with slab nodes so
+// allocation does not drown out the placement cost.
+template<typename Value>
+void benchmark_hinted_insert(std::string const &name, std::vector<Value> const &numbers) {
+  SlabAVLTree<Value> plain_tree, end_tree, previous_tree;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (auto const &number : numbers)
+    plain_tree.insert(number);
+  auto finish = std::chrono::high_resolution_clock::now();
+  auto plain_us = std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+
+  start = std::chrono::high_resolution_clock::now();
+  for (auto const &number : numbers)
+    end_tree.insert(end_tree.end(), number);
+  finish = std::chrono::high_resolution_clock::now();
+  auto end_us = std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+
+  start = std::chrono::high_resolution_clock::now();
+  auto hint = previous_tree.end();
+  for (auto const &number : numbers)
+    hint = previous_tree.insert(hint, number);
+  finish = std::chrono::high_resolution_clock::now();
+  auto previous_us = std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+
+  EXPECT_EQ(plain_tree, end_tree);
+  EXPECT_TRUE(std::equal(plain_tree.begin(), plain_tree.end(), previous_tree.begin(), previous_tree.end()));
+  std::cout << name << " insert: " << plain_us << "us insert(end()): " << end_us << "us insert(previous): "
+            << previous_us << "us" << std::endl;
+}
+
+TEST(AVLTree, benchmark_hinted_insert) {
+  std::size_t size = 1 << 20;
+  std::vector<unsigned int> monotone(size);
+  std::iota(monotone.begin(), monotone.end(), 0);
+  auto nearly_sorted = monotone;
+  std::default_random_engine generator(42);
+  std::uniform_int_distribution<std::size_t> distribution(0, size - 2);
+  for (std::size_t i = 0; i < size / 100; ++i)
+    std::swap(nearly_sorted[distribution(generator)], nearly_sorted[distribution(generator) + 1]);
+  // Keys sharing a long prefix, where every comparison on the way down is expensive.
+  std::vector<std::string> monotone_paths;
+  for (std::size_t i = 0; i < size / 4; ++i) {
+    auto number = std::to_string(i);
+    monotone_paths.push_back("/var/lib/storage/volumes/shard/" + std::string(8 - number.size(), '0') + number);
+  }
+
+  benchmark_hinted_insert("monotone", monotone);
+  benchmark_hinted_insert("nearly sorted", nearly_sorted);
+  benchmark_hinted_insert("monotone paths", monotone_paths);
+}
+
+TEST(AVLTree, erase_range_matches_set) {
+  std::default_random_engine generator(37);
+  std::uniform_int_distribution<unsigned int> distribution(0, 6000);
+  SlabAVLTree<unsigned int> tree;
+  std::set<unsigned int> numbers_set;
+  for (int round = 0; round < 40; ++round) {
+    for (int i = 0; i < 300; ++i) {
+      auto number = distribution(generator);
+      tree.insert(number);
+      numbers_set.insert(number);
+    }
+    auto low = distribution(generator);
+    auto high = low + distribution(generator) / 8;
+    auto last = round % 5 == 0 ? tree.end() : tree.lower_bound(high);
+    auto last_set = round % 5 == 0 ? numbers_set.end() : numbers_set.lower_bound(high);
+    auto itr = tree.erase(tree.lower_bound(low), last);
+    auto expected = numbers_set.erase(numbers_set.lower_bound(low), last_set);
+    EXPECT_EQ(itr == tree.end(), expected == numbers_set.end());
+    if (expected != numbers_set.end()) {
+      EXPECT_EQ(*itr, *expected);
+    }
+    expect_valid_avl(tree, numbers_set);
+  }
+  tree.erase(tree.begin(), tree.end());
+  expect_valid_avl(tree, {});
+}
+
+TEST(AVLTree, benchmark_erase_range) {
+  std::size_t size = 1 << 18;
+  std::vector<unsigned int> numbers(size);
+  std::iota(numbers.begin(), numbers.end(), 0);
+  AVLTree<unsigned int> bulk_tree{numbers.begin(), numbers.end()};
+  AVLTree<unsigned int> single_tree{numbers.begin(), numbers.end()};
+
+  auto start = std::chrono::high_resolution_clock::now();
+  auto itr = single_tree.find(size / 4);
+  for (std::size_t i = 0; i < size / 2; ++i)
+    itr = single_tree.erase(itr);
+  auto finish = std::chrono::high_resolution_clock::now();
+  auto single_us = std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+
+  start = std::chrono::high_resolution_clock::now();
+  bulk_tree.erase(bulk_tree.find(size / 4), bulk_tree.find(3 * size / 4));
+  finish = std::chrono::high_resolution_clock::now();
+  auto bulk_us = std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+
+  EXPECT_EQ(bulk_tree.size(), size / 2);
+  EXPECT_TRUE(std::equal(bulk_tree.begin(), bulk_tree.end(), single_tree.begin(), single_tree.end()));
+  std::cout << "erase one at a time: " << single_us << "us erase range: " << bulk_us << "us" << std::endl;
+}
+
+TEST(AVLTree, split_and_join_match_set) {
+  auto numbers = generate_random_data<unsigned int>(3000);
+  std::set<unsigned int> numbers_set(numbers.begin(), numbers.end());
+  AVLTree<unsigned int> tree;
+  for (auto number : numbers)
+    tree.insert(number);
+  for (auto key : {numbers[0], numbers[1] + 1, 0u, *numbers_set.rbegin() + 1, *numbers_set.begin()}) {
+    auto right = tree.split(key);
+    std::set<unsigned int> left_set(numbers_set.begin(), numbers_set.lower_bound(key));
+    std::set<unsigned int> right_set(numbers_set.lower_bound(key), numbers_set.end());
+    expect_valid_avl(tree, left_set);
+    expect_valid_avl(right, right_set);
+    tree.join(std::move(right));
+    expect_valid_avl(tree, numbers_set);
+  }
+  tree.erase(numbers[2]);
+  tree.insert(numbers[2] + 1);
+  numbers_set.erase(numbers[2]);
+  numbers_set.insert(numbers[2] + 1);
+  expect_valid_avl(tree, numbers_set);
+}
+
+template<typename Tree>
+void check_set_operations(std::size_t first_size, std::size_t second_size) {
+  std::default_random_engine generator(first_size + second_size);
+  std::uniform_int_distribution<unsigned int> distribution(0, 2 * (first_size + second_size));
+  std::set<unsigned int> first_set, second_set;
+  while (first_set.size() < first_size)
+    first_set.insert(distribution(generator));
+  while (second_set.size() < second_size)
+    second_set.insert(distribution(generator));
+  Tree first{first_set.begin(), first_set.end()};
+  Tree second;
+  for (auto number : second_set)
+    second.insert(number);
+
+  std::set<unsigned int> expected;
+  auto united = first;
+  united.union_with(second);
+  std::set_union(first_set.begin(), first_set.end(), second_set.begin(), second_set.end(),
+                 std::inserter(expected, expected.end()));
+  expect_valid_avl(united, expected);
+
+  expected.clear();
+  auto intersection = first;
+  intersection.intersect(second);
+  std::set_intersection(first_set.begin(), first_set.end(), second_set.begin(), second_set.end(),
+                        std::inserter(expected, expected.end()));
+  expect_valid_avl(intersection, expected);
+
+  expected.clear();
+  auto difference = first;
+  difference.difference(std::move(second));
+  std::set_difference(first_set.begin(), first_set.end(), second_set.begin(), second_set.end(),
+                      std::inserter(expected, expected.end()));
+  expect_valid_avl(difference, expected);
+
+  for (unsigned int i = 0; i < 200; ++i) {
+    auto number = distribution(generator);
+    if (i % 2) {
+      difference.erase(number);
+      expected.erase(number);
+    } else {
+      difference.insert(number);
+      expected.insert(number);
+    }
+  }
+  expect_valid_avl(difference, expected);
+}
+
+TEST(AVLTree, set_operations_match_std) {
+  for (auto[first_size, second_size] : {std::pair<std::size_t, std::size_t>{0, 0}, {0, 10}, {10, 0}, {1, 1},
+                                        {100, 3}, {3, 100}, {1000, 1000}, {5000, 50}}) {
+    check_set_operations<AVLTree<unsigned int>>(first_size, second_size);
+    check_set_operations<SlabAVLTree<unsigned int>>(first_size, second_size);
+  }
+}
+
+TEST(AVLTree, parallel_set_operations_match_std) {
+  check_set_operations<AVLTree<unsigned int>>(1 << 17, 1 << 16);
+}
+
+TEST(AVLTree, benchmark_union_vs_insert) {
+  std::size_t size = 1 << 19;
+  std::vector<unsigned int> evens(size), odds(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    evens[i] = 2 * i;
+    odds[i] = 2 * i + 1;
+  }
+  AVLTree<unsigned int> first{evens.begin(), evens.end()};
+  AVLTree<unsigned int> second{odds.begin(), odds.end()};
+  auto inserted = first;
+  auto united = first;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (auto number : second)
+    inserted.insert(number);
+  auto finish = std::chrono::high_resolution_clock::now();
+  auto insert_us = std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+
+  start = std::chrono::high_resolution_clock::now();
+  united.union_with(std::move(second));
+  finish = std::chrono::high_resolution_clock::now();
+  auto union_us = std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+
+  EXPECT_EQ(united, inserted);
+  EXPECT_EQ(united.size(), 2 * size);
+  std::cout << "insert: " << insert_us << "us union_with: " << union_us << "us" << std::endl;
+}
+
+TEST(AVLTree, benchmark_find_batch_vs_find) {
+  std::size_t size = 1 << 21;
+  std::vector<unsigned int> numbers(size);
+  for (std::size_t i = 0; i < size; ++i)
+    numbers[i] = 2 * i;
+  AVLTree<unsigned int> avl_tree{numbers.begin(), numbers.end()};
+  std::default_random_engine generator(42);
+  std::uniform_int_distribution<unsigned int> distribution(0, 2 * size);
+  std::vector<unsigned int> keys(1 << 18);
+  for (auto &key : keys)
+    key = distribution(generator);
+  auto const &tree = avl_tree;
+  std::vector<AVLTree<unsigned int>::const_iterator> found(keys.size());
+  std::vector<AVLTree<unsigned int>::const_iterator> found_batch(keys.size());
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (std::size_t i = 0; i < keys.size(); ++i)
+    found[i] = tree.find(keys[i]);
+  auto finish = std::chrono::high_resolution_clock::now();
+  auto find_us = std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+
+  start = std::chrono::high_resolution_clock::now();
+  tree.find_batch(keys, found_batch);
+  finish = std::chrono::high_resolution_clock::now();
+  auto find_batch_us = std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+
+  EXPECT_EQ(found, found_batch);
+  std::cout << "find: " << find_us << "us find_batch: " << find_batch_us << "us" << std::endl;
+}
+
+}
@@ -0,0 +1,153 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_AVL_COMPACT_AVL_TREE_H_
+#define ALGORITHMS_TREES_AVL_COMPACT_AVL_TREE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace trees::avl {
+
+// AVL tree whose nodes live in one contiguous vector and link to each other by 32-bit index, with
+// the balance factor packed into the top bits of the parent index. A node costs sizeof(T) plus 12
+// bytes instead of the three pointers of AVLNode, and nodes allocated together stay together.
+// Erasing moves the last node of the vector into the freed slot, which invalidates iterators.
+template<typename T, typename Comparator = std::less<T>>
+class CompactAVLTree {
+  struct Node {
+    T data;
+    std::uint32_t left;
+    std::uint32_t right;
+    // Parent index in the low 30 bits, balance + 1 in the top two.
+    std::uint32_t parent_balance;
+  };
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  static constexpr std::uint32_t nil = (std::uint32_t{1} << 30) - 1;
+  static constexpr std::size_t node_size = sizeof(Node);
+
+  class const_iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T const;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T const *;
+    using reference = T const &;
+
+    inline const_iterator() : tree_{nullptr}, index_{nil} {}
+    inline const_iterator(CompactAVLTree const *tree, std::uint32_t index) : tree_{tree}, index_{index} {}
+
+    [[nodiscard]] inline reference operator*() const { return tree_->nodes_[index_].data; }
+    [[nodiscard]] inline pointer operator->() const { return &tree_->nodes_[index_].data; }
+    inline const_iterator &operator++() {
+      index_ = tree_->next(index_);
+      return *this;
+    }
+    inline const_iterator operator++(int) {
+      auto res = *this;
+      ++*this;
+      return res;
+    }
+    inline const_iterator &operator--() {
+      index_ = tree_->prev(index_);
+      return *this;
+    }
+    inline const_iterator operator--(int) {
+      auto res = *this;
+      --*this;
+      return res;
+    }
+    [[nodiscard]] inline bool operator==(const_iterator const &other) const { return index_ == other.index_; }
+    [[nodiscard]] inline bool operator!=(const_iterator const &other) const { return index_ != other.index_; }
+
+   private:
+    CompactAVLTree const *tree_;
+    std::uint32_t index_;
+  };
+
+  using iterator = const_iterator;
+
+  inline explicit CompactAVLTree(Comparator comp = Comparator()) : comp_{comp}, root_{nil} {}
+
+  [[nodiscard]] inline const_iterator begin() const { return const_iterator(this, leftmost(root_)); }
+  [[nodiscard]] inline const_iterator end() const { return const_iterator(this, nil); }
+
+  std::pair<const_iterator, bool> insert(value_type value);
+  std::size_t erase(value_type const &value);
+  void clear();
+  // Reserves room for count nodes, so filling the tree does not reallocate the vector.
+  inline void reserve(std::size_t count) { nodes_.reserve(count); }
+
+  [[nodiscard]] inline std::size_t size() const { return nodes_.size(); }
+  [[nodiscard]] inline bool empty() const { return nodes_.empty(); }
+  [[nodiscard]] std::size_t height() const;
+  [[nodiscard]] const_iterator find(value_type const &value) const;
+  [[nodiscard]] const_iterator lower_bound(value_type const &value) const;
+  [[nodiscard]] inline bool contains(value_type const &value) const { return find(value) != end(); }
+  // Bytes held by the tree, counting the spare capacity of the node vector.
+  [[nodiscard]] inline std::size_t memory_usage() const { return sizeof(*this) + nodes_.capacity() * sizeof(Node); }
+
+ private:
+  Comparator comp_;
+  std::vector<Node> nodes_;
+  std::uint32_t root_;
+
+  [[nodiscard]] inline std::uint32_t left(std::uint32_t node) const { return nodes_[node].left; }
+  [[nodiscard]] inline std::uint32_t right(std::uint32_t node) const { return nodes_[node].right; }
+  [[nodiscard]] inline std::uint32_t parent(std::uint32_t node) const { return nodes_[node].parent_balance & nil; }
+  [[nodiscard]] inline int balance(std::uint32_t node) const {
+    return static_cast<int>(nodes_[node].parent_balance >> 30) - 1;
+  }
+  inline void parent(std::uint32_t node, std::uint32_t parent) {
+    nodes_[node].parent_balance = (nodes_[node].parent_balance & ~nil) | parent;
+  }
+  inline void balance(std::uint32_t node, int balance) {
+    nodes_[node].parent_balance = (nodes_[node].parent_balance & nil) | static_cast<std::uint32_t>(balance + 1) << 30;
+  }
+
+  [[nodiscard]] std::uint32_t leftmost(std::uint32_t node) const;
+  [[nodiscard]] std::uint32_t rightmost(std::uint32_t node) const;
+  [[nodiscard]] std::uint32_t next(std::uint32_t node) const;
+  [[nodiscard]] std::uint32_t prev(std::uint32_t node) const;
+  [[nodiscard]] std::uint32_t find_node(value_type const &value) const;
+
+  void replace_child(std::uint32_t parent, std::uint32_t child, std::uint32_t replacement);
+  std::uint32_t rotate_left(std::uint32_t node);
+  std::uint32_t rotate_right(std::uint32_t node);
+  // Restores a node whose balance reached weight (+2 or -2), returning the new root of its subtree.
+  std::uint32_t rebalance(std::uint32_t node, int weight);
+  void retrace_insert(std::uint32_t node);
+  void retrace_erase(std::uint32_t node, int side);
+  void relocate_last(std::uint32_t slot);
+};
+
+}
+#endif //ALGORITHMS_TREES_AVL_COMPACT_AVL_TREE_H_
@@ -0,0 +1,312 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_AVL_COMPACT_AVL_TREE_IPP_
+#define ALGORITHMS_TREES_AVL_COMPACT_AVL_TREE_IPP_
+
+#include <stdexcept>
+#include <utility>
+#include <trees/avl/compact_avl_tree.h>
+
+namespace trees::avl {
+
+template<typename T, typename Comparator>
+std::uint32_t CompactAVLTree<T, Comparator>::leftmost(std::uint32_t node) const {
+  if (node == nil)
+    return nil;
+  while (left(node) != nil)
+    node = left(node);
+  return node;
+}
+
+template<typename T, typename Comparator>
+std::uint32_t CompactAVLTree<T, Comparator>::rightmost(std::uint32_t node) const {
+  if (node == nil)
+    return nil;
+  while (right(node) != nil)
+    node = right(node);
+  return node;
+}
+
+template<typename T, typename Comparator>
+std::uint32_t CompactAVLTree<T, Comparator>::next(std::uint32_t node) const {
+  if (right(node) != nil)
+    return leftmost(right(node));
+  auto up = parent(node);
+  while (up != nil && right(up) == node) {
+    node = up;
+    up = parent(up);
+  }
+  return up;
+}
+
+template<typename T, typename Comparator>
+std::uint32_t CompactAVLTree<T, Comparator>::prev(std::uint32_t node) const {
+  if (node == nil)
+    return rightmost(root_);
+  if (left(node) != nil)
+    return rightmost(left(node));
+  auto up = parent(node);
+  while (up != nil && left(up) == node) {
+    node = up;
+    up = parent(up);
+  }
+  return up;
+}
+
+template<typename T, typename Comparator>
+std::uint32_t CompactAVLTree<T, Comparator>::find_node(value_type const &value) const {
+  auto node = root_;
+  while (node != nil) {
+    if (comp_(value, nodes_[node].data))
+      node = left(node);
+    else if (comp_(nodes_[node].data, value))
+      node = right(node);
+    else
+      break;
+  }
+  return node;
+}
+
+template<typename T, typename Comparator>
+typename CompactAVLTree<T, Comparator>::const_iterator
+CompactAVLTree<T, Comparator>::find(value_type const &value) const {
+  return const_iterator(this, find_node(value));
+}
+
+template<typename T, typename Comparator>
+typename CompactAVLTree<T, Comparator>::const_iterator
+CompactAVLTree<T, Comparator>::lower_bound(value_type const &value) const {
+  auto res = nil;
+  for (auto node = root_; node != nil;) {
+    if (comp_(nodes_[node].data, value)) {
+      node = right(node);
+    } else {
+      res = node;
+      node = left(node);
+    }
+  }
+  return const_iterator(this, res);
+}
+
+template<typename T, typename Comparator>
+std::size_t CompactAVLTree<T, Comparator>::height() const {
+  std::size_t res = 0;
+  if (root_ == nil)
+    return res;
+  for (auto node = root_; ; ++res) {
+    node = balance(node) > 0 ? right(node) : left(node);
+    if (node == nil)
+      break;
+  }
+  return res;
+}
+
+template<typename T, typename Comparator>
+void CompactAVLTree<T, Comparator>::clear() {
+  nodes_.clear();
+  root_ = nil;
+}
+
+template<typename T, typename Comparator>
+std::pair<typename CompactAVLTree<T, Comparator>::const_iterator, bool>
+CompactAVLTree<T, Comparator>::insert(value_type value) {
+  auto up = nil;
+  int side = 0;
+  for (auto node = root_; node != nil;) {
+    up = node;
+    if (comp_(value, nodes_[node].data)) {
+      side = -1;
+      node = left(node);
+    } else if (comp_(nodes_[node].data, value)) {
+      side = 1;
+      node = right(node);
+    } else {
+      return std::make_pair(const_iterator(this, node), false);
+    }
+  }
+  if (nodes_.size() >= nil)
+    throw std::length_error("CompactAVLTree is full");
+  auto node = static_cast<std::uint32_t>(nodes_.size());
+  nodes_.push_back(Node{std::move(value), nil, nil, up | std::uint32_t{1} << 30});
+  if (up == nil)
+    root_ = node;
+  else if (side < 0)
+    nodes_[up].left = node;
+  else
+    nodes_[up].right = node;
+  retrace_insert(node);
+  return std::make_pair(const_iterator(this, node), true);
+}
+
+template<typename T, typename Comparator>
+std::size_t CompactAVLTree<T, Comparator>::erase(value_type const &value) {
+  auto node = find_node(value);
+  if (node == nil)
+    return 0;
+  if (left(node) != nil && right(node) != nil) {
+    auto successor = leftmost(right(node));
+    nodes_[node].data = std::move(nodes_[successor].data);
+    node = successor;
+  }
+  auto child = left(node) != nil ? left(node) : right(node);
+  auto up = parent(node);
+  int side = up != nil && left(up) == node ? -1 : 1;
+  if (child != nil)
+    parent(child, up);
+  replace_child(up, node, child);
+  if (up != nil)
+    retrace_erase(up, side);
+  relocate_last(node);
+  return 1;
+}
+
+template<typename T, typename Comparator>
+void CompactAVLTree<T, Comparator>::replace_child(std::uint32_t parent,
+                                                  std::uint32_t child,
+                                                  std::uint32_t replacement) {
+  if (parent == nil)
+    root_ = replacement;
+  else if (left(parent) == child)
+    nodes_[parent].left = replacement;
+  else
+    nodes_[parent].right = replacement;
+}
+
+template<typename T, typename Comparator>
+std::uint32_t CompactAVLTree<T, Comparator>::rotate_left(std::uint32_t node) {
+  auto pivot = right(node);
+  auto inner = left(pivot);
+  auto up = parent(node);
+  nodes_[node].right = inner;
+  if (inner != nil)
+    parent(inner, node);
+  nodes_[pivot].left = node;
+  parent(node, pivot);
+  parent(pivot, up);
+  replace_child(up, node, pivot);
+  return pivot;
+}
+
+template<typename T, typename Comparator>
+std::uint32_t CompactAVLTree<T, Comparator>::rotate_right(std::uint32_t node) {
+  auto pivot = left(node);
+  auto inner = right(pivot);
+  auto up = parent(node);
+  nodes_[node].left = inner;
+  if (inner != nil)
+    parent(inner, node);
+  nodes_[pivot].right = node;
+  parent(node, pivot);
+  parent(pivot, up);
+  replace_child(up, node, pivot);
+  return pivot;
+}
+
+// The balance of node cannot be stored while it is off by two, so it arrives as weight and the
+// rotations leave the final balances, taken from the usual single and double rotation cases.
+template<typename T, typename Comparator>
+std::uint32_t CompactAVLTree<T, Comparator>::rebalance(std::uint32_t node, int weight) {
+  auto child = weight > 0 ? right(node) : left(node);
+  auto child_balance = balance(child);
+  if (child_balance * weight >= 0) {
+    auto root = weight > 0 ? rotate_left(node) : rotate_right(node);
+    auto tilt = weight > 0 ? 1 : -1;
+    balance(node, child_balance == 0 ? tilt : 0);
+    balance(root, child_balance == 0 ? -tilt : 0);
+    return root;
+  }
+  auto grandchild = weight > 0 ? left(child) : right(child);
+  auto grandchild_balance = balance(grandchild);
+  if (weight > 0) {
+    rotate_right(child);
+    rotate_left(node);
+    balance(node, grandchild_balance > 0 ? -1 : 0);
+    balance(child, grandchild_balance < 0 ? 1 : 0);
+  } else {
+    rotate_left(child);
+    rotate_right(node);
+    balance(node, grandchild_balance < 0 ? 1 : 0);
+    balance(child, grandchild_balance > 0 ? -1 : 0);
+  }
+  balance(grandchild, 0);
+  return grandchild;
+}
+
+template<typename T, typename Comparator>
+void CompactAVLTree<T, Comparator>::retrace_insert(std::uint32_t node) {
+  for (auto up = parent(node); up != nil; node = up, up = parent(up)) {
+    auto weight = balance(up) + (left(up) == node ? -1 : 1);
+    if (weight == 0) {
+      balance(up, 0);
+      return;
+    }
+    if (weight == 2 || weight == -2) {
+      rebalance(up, weight);
+      return;
+    }
+    balance(up, weight);
+  }
+}
+
+// side tells which subtree of node just got shorter.
+template<typename T, typename Comparator>
+void CompactAVLTree<T, Comparator>::retrace_erase(std::uint32_t node, int side) {
+  while (node != nil) {
+    auto weight = balance(node) - side;
+    if (weight == 1 || weight == -1) {
+      balance(node, weight);
+      return;
+    }
+    if (weight != 0) {
+      node = rebalance(node, weight);
+      if (balance(node) != 0)
+        return;
+    } else {
+      balance(node, 0);
+    }
+    auto up = parent(node);
+    side = up != nil && left(up) == node ? -1 : 1;
+    node = up;
+  }
+}
+
+// Fills slot, just unlinked from the tree, with the last node of the vector so the nodes stay
+// contiguous.
+template<typename T, typename Comparator>
+void CompactAVLTree<T, Comparator>::relocate_last(std::uint32_t slot) {
+  auto last = static_cast<std::uint32_t>(nodes_.size() - 1);
+  if (slot != last) {
+    nodes_[slot] = std::move(nodes_[last]);
+    replace_child(parent(slot), last, slot);
+    if (left(slot) != nil)
+      parent(left(slot), slot);
+    if (right(slot) != nil)
+      parent(right(slot), slot);
+  }
+  nodes_.pop_back();
+}
+
+}
+#endif //ALGORITHMS_TREES_AVL_COMPACT_AVL_TREE_IPP_
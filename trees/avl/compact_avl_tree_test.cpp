@@ -0,0 +1,126 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <trees/avl/compact_avl_tree.h>
+#include <trees/avl/compact_avl_tree.ipp>
+#include <trees/avl/avl_tree.h>
+#include <trees/avl/avl_tree.ipp>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace trees::avl::test {
+
+TEST(CompactAVLTree, node_is_smaller_than_avl_node) {
+  EXPECT_EQ(CompactAVLTree<unsigned int>::node_size, 16);
+  EXPECT_LT(CompactAVLTree<unsigned int>::node_size, sizeof(detail::AVLNode<unsigned int>));
+}
+
+TEST(CompactAVLTree, random_insert_and_erase_matches_set) {
+  std::default_random_engine generator(29);
+  std::uniform_int_distribution<int> distribution(0, 5000);
+  CompactAVLTree<int> tree;
+  std::set<int> numbers_set;
+  for (int i = 0; i < 40000; ++i) {
+    auto number = distribution(generator);
+    if (i % 3 == 2)
+      EXPECT_EQ(tree.erase(number), numbers_set.erase(number));
+    else
+      EXPECT_EQ(tree.insert(number).second, numbers_set.insert(number).second);
+    ASSERT_EQ(tree.size(), numbers_set.size());
+  }
+  EXPECT_TRUE(std::equal(tree.begin(), tree.end(), numbers_set.begin(), numbers_set.end()));
+  EXPECT_LE(tree.height(), 1.44 * std::log2(numbers_set.size() + 2));
+  std::vector<int> reversed;
+  for (auto itr = tree.end(); itr != tree.begin();)
+    reversed.push_back(*--itr);
+  EXPECT_TRUE(std::equal(reversed.begin(), reversed.end(), numbers_set.rbegin(), numbers_set.rend()));
+  for (int key = -1; key <= 5001; key += 7) {
+    EXPECT_EQ(tree.contains(key), numbers_set.count(key) == 1);
+    auto bound = tree.lower_bound(key);
+    auto expected = numbers_set.lower_bound(key);
+    if (expected == numbers_set.end())
+      EXPECT_EQ(bound, tree.end());
+    else
+      EXPECT_EQ(*bound, *expected);
+  }
+  for (auto number : std::vector<int>(numbers_set.begin(), numbers_set.end()))
+    EXPECT_EQ(tree.erase(number), 1);
+  EXPECT_TRUE(tree.empty());
+  EXPECT_EQ(tree.begin(), tree.end());
+}
+
+TEST(CompactAVLTree, sorted_insert_stays_balanced) {
+  CompactAVLTree<std::string> tree;
+  for (int i = 0; i < 4096; ++i)
+    tree.insert(std::to_string(100000 + i));
+  EXPECT_EQ(tree.size(), 4096);
+  EXPECT_EQ(tree.height(), 12);
+  EXPECT_EQ(*tree.begin(), "100000");
+  EXPECT_EQ(*tree.find("102048"), "102048");
+}
+
+TEST(CompactAVLTree, benchmark_memory_and_find) {
+  std::size_t size = 1 << 18;
+  std::vector<unsigned int> numbers(size);
+  std::default_random_engine generator(31);
+  std::uniform_int_distribution<unsigned int> distribution;
+  for (auto &number : numbers)
+    number = distribution(generator);
+
+  AVLTree<unsigned int> tree;
+  CompactAVLTree<unsigned int> compact;
+  compact.reserve(size);
+  for (auto number : numbers) {
+    tree.insert(number);
+    compact.insert(number);
+  }
+  ASSERT_EQ(tree.size(), compact.size());
+
+  auto start = std::chrono::high_resolution_clock::now();
+  std::size_t found = 0;
+  for (auto number : numbers)
+    found += tree.find(number) != tree.end();
+  auto finish = std::chrono::high_resolution_clock::now();
+  auto tree_us = std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+
+  start = std::chrono::high_resolution_clock::now();
+  std::size_t compact_found = 0;
+  for (auto number : numbers)
+    compact_found += compact.contains(number);
+  finish = std::chrono::high_resolution_clock::now();
+  auto compact_us = std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+  EXPECT_EQ(found, compact_found);
+
+  std::cout << "bytes per element AVLTree node: " << sizeof(detail::AVLNode<unsigned int>)
+            << " CompactAVLTree: " << static_cast<double>(compact.memory_usage()) / compact.size() << std::endl;
+  std::cout << "find AVLTree: " << tree_us << "us CompactAVLTree: " << compact_us << "us" << std::endl;
+}
+
+}
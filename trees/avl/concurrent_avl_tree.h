@@ -0,0 +1,103 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_AVL_CONCURRENT_AVL_TREE_H_
+#define ALGORITHMS_TREES_AVL_CONCURRENT_AVL_TREE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include <trees/rcu.h>
+
+namespace trees::avl {
+
+// AVL set for read-mostly sharing between threads. Readers never block: they pin a grace period
+// and walk whatever root was published last. Writers take a mutex and never modify a published
+// node; they copy the search path (and any node touched by a rotation), publish the new root and
+// retire the replaced nodes, which are freed in batches once no reader can still hold them. The
+// writer that frees a batch waits for the readers running at that moment to finish.
+template<typename T, typename Comparator = std::less<T>>
+class ConcurrentAVLTree {
+ public:
+  using value_type = T;
+
+  explicit ConcurrentAVLTree(Comparator comp = Comparator());
+  ConcurrentAVLTree(ConcurrentAVLTree const &) = delete;
+  ConcurrentAVLTree &operator=(ConcurrentAVLTree const &) = delete;
+  ~ConcurrentAVLTree();
+
+  bool insert(value_type value);
+  std::size_t erase(value_type const &value);
+  void clear();
+
+  [[nodiscard]] inline std::size_t size() const { return size_.load(std::memory_order_relaxed); }
+  [[nodiscard]] bool contains(value_type const &value) const;
+  [[nodiscard]] std::optional<value_type> find(value_type const &value) const;
+  [[nodiscard]] std::optional<value_type> lower_bound(value_type const &value) const;
+
+  // Visits one consistent snapshot in order. Writers can publish meanwhile, but reclaiming their
+  // garbage waits until function returns, so function must not insert, erase or clear: a write
+  // that reclaims would wait for the visit it runs in.
+  template<typename Function>
+  void for_each(Function function) const;
+
+ private:
+  struct Node {
+    T value;
+    Node *left;
+    Node *right;
+    int height;
+  };
+
+  static constexpr std::size_t retire_batch = 1024;
+
+  Comparator comp_;
+  std::atomic<Node *> root_;
+  std::atomic<std::size_t> size_;
+  std::mutex writer_;
+  detail::ReadCopyUpdate rcu_;
+  std::vector<Node *> retired_;
+  std::vector<Node *> replaced_;
+  std::vector<Node *> built_;
+
+  [[nodiscard]] Node const *lower_bound_node(value_type const &value) const;
+
+  static inline int height(Node const *node) { return node ? node->height : 0; }
+  Node *make(T value, Node *left, Node *right);
+  Node *balance(T const &value, Node *left, Node *right);
+  Node *insert(Node *node, T &value, bool &inserted);
+  Node *erase(Node *node, T const &value, bool &erased);
+  Node *erase_min(Node *node, Node *&min);
+  void retire(Node *node);
+  void publish(Node *root);
+  void abandon();
+  void reclaim();
+  static void destroy(Node *node);
+};
+
+}
+#endif //ALGORITHMS_TREES_AVL_CONCURRENT_AVL_TREE_H_
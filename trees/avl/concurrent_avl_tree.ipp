@@ -0,0 +1,295 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_AVL_CONCURRENT_AVL_TREE_IPP_
+#define ALGORITHMS_TREES_AVL_CONCURRENT_AVL_TREE_IPP_
+
+#include <algorithm>
+#include <trees/avl/concurrent_avl_tree.h>
+
+namespace trees::avl {
+
+template<typename T, typename Comparator>
+ConcurrentAVLTree<T, Comparator>::ConcurrentAVLTree(Comparator comp)
+    : comp_{comp}, root_{nullptr}, size_{0} {}
+
+template<typename T, typename Comparator>
+ConcurrentAVLTree<T, Comparator>::~ConcurrentAVLTree() {
+  destroy(root_.load());
+  for (auto node : retired_)
+    delete node;
+}
+
+template<typename T, typename Comparator>
+bool ConcurrentAVLTree<T, Comparator>::insert(value_type value) {
+  std::lock_guard lock{writer_};
+  bool inserted = false;
+  Node *root;
+  try {
+    root = insert(root_.load(), value, inserted);
+  } catch (...) {
+    abandon();
+    throw;
+  }
+  if (inserted) {
+    publish(root);
+    size_.fetch_add(1, std::memory_order_relaxed);
+    reclaim();
+  }
+  return inserted;
+}
+
+template<typename T, typename Comparator>
+std::size_t ConcurrentAVLTree<T, Comparator>::erase(value_type const &value) {
+  std::lock_guard lock{writer_};
+  bool erased = false;
+  Node *root;
+  try {
+    root = erase(root_.load(), value, erased);
+  } catch (...) {
+    abandon();
+    throw;
+  }
+  if (!erased)
+    return 0;
+  publish(root);
+  size_.fetch_sub(1, std::memory_order_relaxed);
+  reclaim();
+  return 1;
+}
+
+template<typename T, typename Comparator>
+void ConcurrentAVLTree<T, Comparator>::clear() {
+  std::lock_guard lock{writer_};
+  auto root = root_.exchange(nullptr);
+  size_.store(0, std::memory_order_relaxed);
+  rcu_.synchronize();
+  destroy(root);
+  for (auto node : retired_)
+    delete node;
+  retired_.clear();
+}
+
+template<typename T, typename Comparator>
+typename ConcurrentAVLTree<T, Comparator>::Node const *
+ConcurrentAVLTree<T, Comparator>::lower_bound_node(value_type const &value) const {
+  Node const *node = root_.load();
+  Node const *res = nullptr;
+  while (node) {
+    if (comp_(node->value, value)) {
+      node = node->right;
+    } else {
+      res = node;
+      node = node->left;
+    }
+  }
+  return res;
+}
+
+template<typename T, typename Comparator>
+bool ConcurrentAVLTree<T, Comparator>::contains(value_type const &value) const {
+  auto guard = rcu_.read_lock();
+  auto node = lower_bound_node(value);
+  return node && !comp_(value, node->value);
+}
+
+template<typename T, typename Comparator>
+std::optional<T> ConcurrentAVLTree<T, Comparator>::find(value_type const &value) const {
+  auto guard = rcu_.read_lock();
+  auto node = lower_bound_node(value);
+  if (node && !comp_(value, node->value))
+    return node->value;
+  return std::nullopt;
+}
+
+template<typename T, typename Comparator>
+std::optional<T> ConcurrentAVLTree<T, Comparator>::lower_bound(value_type const &value) const {
+  auto guard = rcu_.read_lock();
+  auto node = lower_bound_node(value);
+  if (node)
+    return node->value;
+  return std::nullopt;
+}
+
+template<typename T, typename Comparator>
+template<typename Function>
+void ConcurrentAVLTree<T, Comparator>::for_each(Function function) const {
+  auto guard = rcu_.read_lock();
+  std::vector<Node const *> path;
+  Node const *node = root_.load();
+  while (node || !path.empty()) {
+    for (; node; node = node->left)
+      path.push_back(node);
+    node = path.back();
+    path.pop_back();
+    function(node->value);
+    node = node->right;
+  }
+}
+
+// Records every node before building it, so that a write that throws halfway can free them all.
+template<typename T, typename Comparator>
+typename ConcurrentAVLTree<T, Comparator>::Node *
+ConcurrentAVLTree<T, Comparator>::make(T value, Node *left, Node *right) {
+  built_.push_back(nullptr);
+  return built_.back() = new Node{std::move(value), left, right, 1 + std::max(height(left), height(right))};
+}
+
+// Builds the node for value over left and right, whose heights differ by at most two, with a
+// single or double rotation when needed. Rotated children are copied, never modified.
+template<typename T, typename Comparator>
+typename ConcurrentAVLTree<T, Comparator>::Node *
+ConcurrentAVLTree<T, Comparator>::balance(T const &value, Node *left, Node *right) {
+  if (height(left) > height(right) + 1) {
+    retire(left);
+    if (height(left->left) >= height(left->right))
+      return make(left->value, left->left, make(value, left->right, right));
+    auto middle = left->right;
+    retire(middle);
+    return make(middle->value, make(left->value, left->left, middle->left), make(value, middle->right, right));
+  }
+  if (height(right) > height(left) + 1) {
+    retire(right);
+    if (height(right->right) >= height(right->left))
+      return make(right->value, make(value, left, right->left), right->right);
+    auto middle = right->left;
+    retire(middle);
+    return make(middle->value, make(value, left, middle->left), make(right->value, middle->right, right->right));
+  }
+  return make(value, left, right);
+}
+
+template<typename T, typename Comparator>
+typename ConcurrentAVLTree<T, Comparator>::Node *
+ConcurrentAVLTree<T, Comparator>::insert(Node *node, T &value, bool &inserted) {
+  if (!node) {
+    inserted = true;
+    return make(std::move(value), nullptr, nullptr);
+  }
+  Node *res = node;
+  if (comp_(value, node->value)) {
+    auto left = insert(node->left, value, inserted);
+    if (inserted)
+      res = balance(node->value, left, node->right);
+  } else if (comp_(node->value, value)) {
+    auto right = insert(node->right, value, inserted);
+    if (inserted)
+      res = balance(node->value, node->left, right);
+  }
+  if (res != node)
+    retire(node);
+  return res;
+}
+
+template<typename T, typename Comparator>
+typename ConcurrentAVLTree<T, Comparator>::Node *
+ConcurrentAVLTree<T, Comparator>::erase(Node *node, T const &value, bool &erased) {
+  if (!node)
+    return nullptr;
+  Node *res = node;
+  if (comp_(value, node->value)) {
+    auto left = erase(node->left, value, erased);
+    if (erased)
+      res = balance(node->value, left, node->right);
+  } else if (comp_(node->value, value)) {
+    auto right = erase(node->right, value, erased);
+    if (erased)
+      res = balance(node->value, node->left, right);
+  } else {
+    erased = true;
+    if (!node->left) {
+      res = node->right;
+    } else if (!node->right) {
+      res = node->left;
+    } else {
+      Node *min = nullptr;
+      auto right = erase_min(node->right, min);
+      res = balance(min->value, node->left, right);
+    }
+  }
+  if (res != node)
+    retire(node);
+  return res;
+}
+
+template<typename T, typename Comparator>
+typename ConcurrentAVLTree<T, Comparator>::Node *
+ConcurrentAVLTree<T, Comparator>::erase_min(Node *node, Node *&min) {
+  retire(node);
+  if (!node->left) {
+    min = node;
+    return node->right;
+  }
+  auto left = erase_min(node->left, min);
+  return balance(node->value, left, node->right);
+}
+
+// Nodes are only set aside here; they join retired_ once the write publishes its root, so a write
+// that throws never hands live nodes to reclaim. Nodes built during the current write are retired
+// too when a later rotation replaces them; they were never reachable by readers, so deferring
+// their release is merely conservative.
+template<typename T, typename Comparator>
+void ConcurrentAVLTree<T, Comparator>::retire(Node *node) {
+  replaced_.push_back(node);
+}
+
+template<typename T, typename Comparator>
+void ConcurrentAVLTree<T, Comparator>::publish(Node *root) {
+  retired_.reserve(retired_.size() + replaced_.size());
+  root_.store(root);
+  retired_.insert(retired_.end(), replaced_.begin(), replaced_.end());
+  replaced_.clear();
+  built_.clear();
+}
+
+// The published tree is untouched by a failed write; only the nodes it built need freeing.
+template<typename T, typename Comparator>
+void ConcurrentAVLTree<T, Comparator>::abandon() {
+  for (auto node : built_)
+    delete node;
+  built_.clear();
+  replaced_.clear();
+}
+
+template<typename T, typename Comparator>
+void ConcurrentAVLTree<T, Comparator>::reclaim() {
+  if (retired_.size() < retire_batch)
+    return;
+  rcu_.synchronize();
+  for (auto node : retired_)
+    delete node;
+  retired_.clear();
+}
+
+template<typename T, typename Comparator>
+void ConcurrentAVLTree<T, Comparator>::destroy(Node *node) {
+  if (!node)
+    return;
+  destroy(node->left);
+  destroy(node->right);
+  delete node;
+}
+
+}
+#endif
@@ -0,0 +1,224 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <trees/avl/concurrent_avl_tree.h>
+#include <trees/avl/concurrent_avl_tree.ipp>
+#include <trees/avl/avl_tree.h>
+#include <trees/avl/avl_tree.ipp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace trees::avl::test {
+
+TEST(ConcurrentAVLTree, random_insert_and_erase_matches_set) {
+  std::default_random_engine generator(11);
+  std::uniform_int_distribution<int> distribution(0, 4000);
+  ConcurrentAVLTree<int> tree;
+  std::set<int> numbers_set;
+  for (int i = 0; i < 20000; ++i) {
+    auto number = distribution(generator);
+    if (i % 3 == 2) {
+      EXPECT_EQ(tree.erase(number), numbers_set.erase(number));
+    } else {
+      EXPECT_EQ(tree.insert(number), numbers_set.insert(number).second);
+    }
+    ASSERT_EQ(tree.size(), numbers_set.size());
+  }
+  std::vector<int> visited;
+  tree.for_each([&visited](int value) { visited.push_back(value); });
+  EXPECT_TRUE(std::equal(visited.begin(), visited.end(), numbers_set.begin(), numbers_set.end()));
+  for (int key = -1; key <= 4001; ++key) {
+    EXPECT_EQ(tree.contains(key), numbers_set.count(key) == 1);
+    auto expected = numbers_set.lower_bound(key);
+    auto found = tree.lower_bound(key);
+    EXPECT_EQ(found.has_value(), expected != numbers_set.end());
+    if (found) {
+      EXPECT_EQ(*found, *expected);
+    }
+  }
+  tree.clear();
+  EXPECT_EQ(tree.size(), 0);
+  EXPECT_FALSE(tree.find(*numbers_set.begin()));
+}
+
+// Copies are counted so a test can make the n-th one throw in the middle of a write.
+struct FragileKey {
+  static inline int copies_left = -1;
+  int key;
+
+  FragileKey(int key) : key{key} {}
+  FragileKey(FragileKey const &src) : key{src.key} {
+    if (copies_left == 0)
+      throw std::runtime_error("copy failed");
+    if (copies_left > 0)
+      --copies_left;
+  }
+  bool operator<(FragileKey const &other) const { return key < other.key; }
+};
+
+// A write that throws while copying its path must leave the published tree intact and must not
+// retire nodes that are still reachable; enough later writes to reclaim several batches would
+// otherwise free them under the tree.
+TEST(ConcurrentAVLTree, throwing_write_keeps_published_tree) {
+  ConcurrentAVLTree<FragileKey> tree;
+  for (int i = 0; i < 3000; i += 2)
+    tree.insert(i);
+  for (int failures = 0; failures < 50; ++failures) {
+    FragileKey::copies_left = failures % 5;
+    if (failures % 2)
+      EXPECT_THROW(tree.insert(2 * failures + 1), std::runtime_error);
+    else
+      EXPECT_THROW(tree.erase(2 * failures), std::runtime_error);
+    FragileKey::copies_left = -1;
+  }
+  EXPECT_EQ(tree.size(), 1500);
+  for (int i = 1; i < 6000; i += 2) {
+    tree.insert(i);
+    tree.erase(i);
+  }
+  std::vector<int> visited;
+  tree.for_each([&visited](FragileKey const &value) { visited.push_back(value.key); });
+  ASSERT_EQ(visited.size(), 1500);
+  for (std::size_t i = 0; i < visited.size(); ++i)
+    EXPECT_EQ(visited[i], 2 * static_cast<int>(i));
+}
+
+// Even keys are never erased, so every reader must always find them however the writer
+// restructures the tree around them.
+TEST(ConcurrentAVLTree, readers_see_stable_keys_during_writes) {
+  ConcurrentAVLTree<std::string> tree;
+  for (int i = 0; i < 2000; i += 2)
+    tree.insert(std::to_string(i));
+  std::atomic<bool> done{false};
+  std::atomic<std::size_t> misses{0};
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 3; ++r) {
+    readers.emplace_back([&tree, &done, &misses, r] {
+      std::default_random_engine generator(r);
+      std::uniform_int_distribution<int> distribution(0, 999);
+      while (!done.load()) {
+        auto key = std::to_string(2 * distribution(generator));
+        if (tree.find(key) != key)
+          ++misses;
+      }
+    });
+  }
+  std::default_random_engine generator(5);
+  std::uniform_int_distribution<int> distribution(0, 999);
+  for (int i = 0; i < 20000; ++i) {
+    auto key = std::to_string(2 * distribution(generator) + 1);
+    if (i % 2)
+      tree.erase(key);
+    else
+      tree.insert(key);
+  }
+  done = true;
+  for (auto &reader : readers)
+    reader.join();
+  EXPECT_EQ(misses.load(), 0);
+}
+
+template<typename Tree, typename Find, typename Write>
+std::size_t reader_throughput(Tree &tree, unsigned readers, Find find, Write write) {
+  std::atomic<bool> done{false};
+  std::atomic<std::size_t> lookups{0};
+  std::vector<std::thread> threads;
+  for (unsigned r = 0; r < readers; ++r) {
+    threads.emplace_back([&, r] {
+      std::default_random_engine generator(r);
+      std::uniform_int_distribution<int> distribution(0, 1 << 17);
+      std::size_t count = 0;
+      while (!done.load(std::memory_order_relaxed)) {
+        find(tree, distribution(generator));
+        ++count;
+      }
+      lookups += count;
+    });
+  }
+  std::thread writer{[&] {
+    std::default_random_engine generator(99);
+    std::uniform_int_distribution<int> distribution(0, 1 << 17);
+    while (!done.load(std::memory_order_relaxed)) {
+      write(tree, distribution(generator));
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+  }};
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  done = true;
+  for (auto &thread : threads)
+    thread.join();
+  writer.join();
+  return lookups.load() * 5;
+}
+
+TEST(ConcurrentAVLTree, benchmark_reader_scaling_vs_mutex) {
+  ConcurrentAVLTree<int> concurrent_tree;
+  AVLTree<int> locked_tree;
+  std::mutex mutex;
+  for (int i = 0; i < (1 << 17); i += 2) {
+    concurrent_tree.insert(i);
+    locked_tree.insert(i);
+  }
+  auto max_readers = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned readers = 1;; readers = std::min(2 * readers, max_readers)) {
+    auto concurrent = reader_throughput(
+        concurrent_tree, readers,
+        [](auto &tree, int key) { return tree.contains(key); },
+        [](auto &tree, int key) {
+          if (key % 2)
+            tree.erase(key - 1);
+          else
+            tree.insert(key);
+        });
+    auto locked = reader_throughput(
+        locked_tree, readers,
+        [&mutex](auto &tree, int key) {
+          std::lock_guard lock{mutex};
+          return tree.find(key) != tree.end();
+        },
+        [&mutex](auto &tree, int key) {
+          std::lock_guard lock{mutex};
+          if (key % 2)
+            tree.erase(key - 1);
+          else
+            tree.insert(key);
+        });
+    std::cout << readers << " readers: ConcurrentAVLTree " << concurrent << " lookups/s, mutex AVLTree "
+              << locked << " lookups/s" << std::endl;
+    if (readers == max_readers)
+      break;
+  }
+}
+
+}
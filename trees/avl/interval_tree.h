@@ -0,0 +1,127 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_AVL_INTERVAL_TREE_H_
+#define ALGORITHMS_TREES_AVL_INTERVAL_TREE_H_
+
+#include <tuple>
+#include <vector>
+#include <trees/avl/avl_tree.h>
+
+namespace trees::avl {
+
+// Half-open interval [start, end). Ordered by start, then end.
+template<typename Point>
+struct Interval {
+  Point start;
+  Point end;
+
+  [[nodiscard]] inline bool operator==(Interval const &other) const {
+    return start == other.start && end == other.end;
+  }
+  [[nodiscard]] inline bool operator<(Interval const &other) const {
+    return std::tie(start, end) < std::tie(other.start, other.end);
+  }
+};
+
+namespace detail {
+
+template<typename T, template<typename> class Allocator = trees::detail::HeapNodeAllocator>
+struct IntervalNodeTraits;
+
+template<typename T, typename NodeTraits = avl::detail::IntervalNodeTraits<T>>
+class IntervalNode : public AVLNode<T, NodeTraits> {
+  using NodeType = typename NodeTraits::NodeType;
+ public:
+  using pointer = typename AVLNode<T, NodeTraits>::pointer;
+  using point_type = decltype(T::end);
+
+  static constexpr bool is_augmented = true;
+
+  inline explicit IntervalNode(T &&data,
+                               NodeType *parent = nullptr,
+                               pointer left = nullptr,
+                               pointer right = nullptr)
+      : AVLNode<T, NodeTraits>(std::forward<T>(data), parent, std::move(left), std::move(right)),
+        max_end_{this->data().end} {
+    update_augmented();
+  }
+
+  inline IntervalNode(IntervalNode const &src,
+                      NodeType *parent) : AVLNode<T, NodeTraits>(src, parent),
+                                          max_end_{src.max_end_} {}
+
+  // Largest end of any interval in the subtree.
+  [[nodiscard]] inline point_type const &max_end() const { return max_end_; }
+
+  inline void update_augmented() {
+    max_end_ = this->data().end;
+    if (this->left() && max_end_ < this->left()->max_end())
+      max_end_ = this->left()->max_end();
+    if (this->right() && max_end_ < this->right()->max_end())
+      max_end_ = this->right()->max_end();
+  }
+
+  [[nodiscard]] inline bool operator==(NodeType const &other) const {
+    return AVLNode<T, NodeTraits>::operator==(other) && max_end() == other.max_end();
+  }
+ private:
+  point_type max_end_;
+};
+
+template<typename T, template<typename> class Allocator>
+struct IntervalNodeTraits {
+  using NodeType = typename trees::avl::detail::IntervalNode<T, IntervalNodeTraits>;
+  using allocator_type = Allocator<NodeType>;
+};
+
+}
+
+// AVLTree of intervals whose nodes keep the largest end in their subtree, so overlap queries skip
+// every subtree ending before the query starts. A query reporting k intervals visits O(log n + k)
+// nodes for the usual workloads, and never more than O((k + 1) log n).
+template<typename Point, typename NodeType = detail::IntervalNode<Interval<Point>>>
+class IntervalTree : public AVLTree<Interval<Point>, std::less<Interval<Point>>, NodeType> {
+ public:
+  using iterator = typename AVLTree<Interval<Point>, std::less<Interval<Point>>, NodeType>::iterator;
+  using const_iterator = typename AVLTree<Interval<Point>, std::less<Interval<Point>>, NodeType>::const_iterator;
+  using value_type = typename AVLTree<Interval<Point>, std::less<Interval<Point>>, NodeType>::value_type;
+  using AVLTree<Interval<Point>, std::less<Interval<Point>>, NodeType>::AVLTree;
+
+  // Intervals containing point, in order.
+  [[nodiscard]] std::vector<value_type> overlapping(Point const &point) const;
+  // Intervals sharing at least one point with interval, in order. Empty intervals overlap nothing.
+  [[nodiscard]] std::vector<value_type> overlapping(value_type const &interval) const;
+
+ private:
+  // Appends the intervals under node ending after low and starting where starts_before allows.
+  template<typename StartsBefore>
+  void collect(NodeType const *node,
+               Point const &low,
+               StartsBefore starts_before,
+               std::vector<value_type> &out) const;
+};
+
+}
+#endif //ALGORITHMS_TREES_AVL_INTERVAL_TREE_H_
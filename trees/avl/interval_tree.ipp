@@ -0,0 +1,69 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_AVL_INTERVAL_TREE_IPP_
+#define ALGORITHMS_TREES_AVL_INTERVAL_TREE_IPP_
+
+#include <trees/avl/interval_tree.h>
+#include <trees/avl/avl_tree.ipp>
+
+namespace trees::avl {
+
+template<typename Point, typename NodeType>
+std::vector<typename IntervalTree<Point, NodeType>::value_type>
+IntervalTree<Point, NodeType>::overlapping(Point const &point) const {
+  std::vector<value_type> res;
+  collect(this->root(), point, [&point](Point const &start) { return !(point < start); }, res);
+  return res;
+}
+
+template<typename Point, typename NodeType>
+std::vector<typename IntervalTree<Point, NodeType>::value_type>
+IntervalTree<Point, NodeType>::overlapping(value_type const &interval) const {
+  std::vector<value_type> res;
+  if (interval.start < interval.end)
+    collect(this->root(), interval.start, [&interval](Point const &start) { return start < interval.end; }, res);
+  return res;
+}
+
+// Nodes are ordered by start, so once one starts too late its right subtree does too; and a
+// subtree whose max_end is not after low holds nothing that reaches the query.
+template<typename Point, typename NodeType>
+template<typename StartsBefore>
+void IntervalTree<Point, NodeType>::collect(NodeType const *node,
+                                            Point const &low,
+                                            StartsBefore starts_before,
+                                            std::vector<value_type> &out) const {
+  while (node && low < node->max_end()) {
+    collect(node->left(), low, starts_before, out);
+    if (!starts_before(node->data().start))
+      return;
+    if (low < node->data().end)
+      out.push_back(node->data());
+    node = node->right();
+  }
+}
+
+}
+#endif //ALGORITHMS_TREES_AVL_INTERVAL_TREE_IPP_
@@ -0,0 +1,131 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <trees/avl/interval_tree.h>
+#include <trees/avl/interval_tree.ipp>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace trees::avl::test {
+
+namespace {
+
+std::vector<Interval<int>> overlapping(std::set<Interval<int>> const &intervals, int start, int end) {
+  std::vector<Interval<int>> res;
+  for (auto const &interval : intervals)
+    if (interval.start < end && start < interval.end)
+      res.push_back(interval);
+  return res;
+}
+
+}
+
+TEST(IntervalTree, overlapping_small) {
+  IntervalTree<int> tree;
+  for (auto interval : {Interval<int>{15, 20}, {10, 30}, {17, 19}, {5, 20}, {12, 15}, {30, 40}})
+    tree.insert(interval);
+  EXPECT_EQ(tree.overlapping(15), (std::vector<Interval<int>>{{5, 20}, {10, 30}, {15, 20}}));
+  EXPECT_EQ(tree.overlapping(30), (std::vector<Interval<int>>{{30, 40}}));
+  EXPECT_EQ(tree.overlapping(40), std::vector<Interval<int>>{});
+  EXPECT_EQ(tree.overlapping(Interval<int>{19, 31}),
+            (std::vector<Interval<int>>{{5, 20}, {10, 30}, {15, 20}, {30, 40}}));
+  EXPECT_EQ(tree.overlapping(Interval<int>{16, 16}), std::vector<Interval<int>>{});
+  tree.erase(Interval<int>{10, 30});
+  EXPECT_EQ(tree.overlapping(Interval<int>{20, 30}), std::vector<Interval<int>>{});
+}
+
+TEST(IntervalTree, random_updates_match_scan) {
+  std::default_random_engine generator(47);
+  std::uniform_int_distribution<int> start_distribution(0, 10000);
+  std::uniform_int_distribution<int> length_distribution(1, 300);
+  IntervalTree<int> tree;
+  std::set<Interval<int>> expected;
+  for (int i = 0; i < 6000; ++i) {
+    auto start = start_distribution(generator);
+    Interval<int> interval{start, start + length_distribution(generator)};
+    if (i % 3 == 2 && !expected.empty()) {
+      auto victim = expected.lower_bound(Interval<int>{start, 0});
+      if (victim == expected.end())
+        victim = expected.begin();
+      EXPECT_EQ(tree.erase(*victim), 1);
+      expected.erase(victim);
+    } else {
+      EXPECT_EQ(tree.insert(interval).second, expected.insert(interval).second);
+    }
+    if (i % 50 == 0) {
+      auto point = start_distribution(generator);
+      EXPECT_EQ(tree.overlapping(point), overlapping(expected, point, point + 1));
+      EXPECT_EQ(tree.overlapping(Interval<int>{point, point + 100}), overlapping(expected, point, point + 100));
+    }
+  }
+  ASSERT_EQ(tree.size(), expected.size());
+  std::vector<Interval<int>> sorted(expected.begin(), expected.end());
+  tree.assign_sorted(sorted.begin(), sorted.end());
+  for (int point = 0; point < 10300; point += 97)
+    EXPECT_EQ(tree.overlapping(point), overlapping(expected, point, point + 1));
+}
+
+TEST(IntervalTree, benchmark_point_queries) {
+  std::size_t size = 1 << 16;
+  std::default_random_engine generator(53);
+  std::uniform_int_distribution<int> start_distribution(0, 1 << 24);
+  std::uniform_int_distribution<int> length_distribution(1, 1 << 10);
+  std::vector<Interval<int>> intervals;
+  IntervalTree<int> tree;
+  for (std::size_t i = 0; i < size; ++i) {
+    auto start = start_distribution(generator);
+    Interval<int> interval{start, start + length_distribution(generator)};
+    if (tree.insert(interval).second)
+      intervals.push_back(interval);
+  }
+  std::vector<int> points(1 << 10);
+  for (auto &point : points)
+    point = start_distribution(generator);
+
+  std::size_t tree_hits = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (auto point : points)
+    tree_hits += tree.overlapping(point).size();
+  auto finish = std::chrono::high_resolution_clock::now();
+  auto tree_us = std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+
+  std::size_t scan_hits = 0;
+  start = std::chrono::high_resolution_clock::now();
+  for (auto point : points)
+    scan_hits += std::count_if(intervals.begin(), intervals.end(), [point](auto const &interval) {
+      return interval.start <= point && point < interval.end;
+    });
+  finish = std::chrono::high_resolution_clock::now();
+  auto scan_us = std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+
+  EXPECT_EQ(tree_hits, scan_hits);
+  std::cout << "point queries IntervalTree: " << tree_us << "us linear scan: " << scan_us << "us" << std::endl;
+}
+
+}
@@ -0,0 +1,104 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_AVL_ORDER_STATISTIC_TREE_H_
+#define ALGORITHMS_TREES_AVL_ORDER_STATISTIC_TREE_H_
+
+#include <trees/avl/avl_tree.h>
+
+namespace trees::avl {
+
+namespace detail {
+
+template<typename T, template<typename> class Allocator = trees::detail::HeapNodeAllocator>
+struct OrderStatisticNodeTraits;
+
+template<typename T, typename NodeTraits = avl::detail::OrderStatisticNodeTraits<T>>
+class OrderStatisticNode : public AVLNode<T, NodeTraits> {
+  using NodeType = typename NodeTraits::NodeType;
+ public:
+  using pointer = typename AVLNode<T, NodeTraits>::pointer;
+
+  static constexpr bool is_augmented = true;
+  static constexpr bool has_subtree_size = true;
+
+  inline explicit OrderStatisticNode(T &&data,
+                                     NodeType *parent = nullptr,
+                                     pointer left = nullptr,
+                                     pointer right = nullptr)
+      : AVLNode<T, NodeTraits>(std::forward<T>(data), parent, std::move(left), std::move(right)),
+        size_{1} {
+    update_augmented();
+  }
+
+  inline OrderStatisticNode(OrderStatisticNode const &src,
+                            NodeType *parent) : AVLNode<T, NodeTraits>(src, parent),
+                                                size_{src.size_} {}
+
+  [[nodiscard]] inline std::size_t size() const { return size_; }
+
+  [[nodiscard]] static inline std::size_t size(NodeType const *node) {
+    return node ? node->size() : 0;
+  }
+
+  inline void update_augmented() {
+    size_ = 1 + size(this->left()) + size(this->right());
+  }
+
+  [[nodiscard]] inline bool operator==(NodeType const &other) const {
+    return AVLNode<T, NodeTraits>::operator==(other) && size() == other.size();
+  }
+ private:
+  std::size_t size_;
+};
+
+template<typename T, template<typename> class Allocator>
+struct OrderStatisticNodeTraits {
+  using NodeType = typename trees::avl::detail::OrderStatisticNode<T, OrderStatisticNodeTraits>;
+  using allocator_type = Allocator<NodeType>;
+};
+
+}
+
+// AVLTree whose nodes keep their subtree size, giving positional access in O(log n).
+template<typename T, typename Comparator = std::less<T>, typename NodeType = detail::OrderStatisticNode<T>>
+class OrderStatisticTree : public AVLTree<T, Comparator, NodeType> {
+ public:
+  using iterator = typename AVLTree<T, Comparator, NodeType>::iterator;
+  using const_iterator = typename AVLTree<T, Comparator, NodeType>::const_iterator;
+  using value_type = typename AVLTree<T, Comparator, NodeType>::value_type;
+  using AVLTree<T, Comparator, NodeType>::AVLTree;
+
+  [[nodiscard]] iterator nth(std::size_t index);
+  [[nodiscard]] const_iterator nth(std::size_t index) const;
+  [[nodiscard]] std::size_t rank(value_type const &value) const;
+  [[nodiscard]] std::size_t rank(const_iterator position) const;
+  [[nodiscard]] iterator advance(const_iterator position, std::ptrdiff_t offset);
+
+ private:
+  [[nodiscard]] NodeType *nth_node(std::size_t index) const;
+};
+
+}
+#endif //ALGORITHMS_TREES_AVL_ORDER_STATISTIC_TREE_H_
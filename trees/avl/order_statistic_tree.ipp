@@ -0,0 +1,101 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_AVL_ORDER_STATISTIC_TREE_IPP_
+#define ALGORITHMS_TREES_AVL_ORDER_STATISTIC_TREE_IPP_
+
+#include <trees/avl/order_statistic_tree.h>
+#include <trees/avl/avl_tree.ipp>
+
+namespace trees::avl {
+
+template<typename T, typename Comparator, typename NodeType>
+NodeType *OrderStatisticTree<T, Comparator, NodeType>::nth_node(std::size_t index) const {
+  auto node = this->root();
+  while (node) {
+    auto left_size = NodeType::size(node->left());
+    if (index < left_size) {
+      node = node->left();
+    } else if (index == left_size) {
+      return node;
+    } else {
+      index -= left_size + 1;
+      node = node->right();
+    }
+  }
+  return nullptr;
+}
+
+template<typename T, typename Comparator, typename NodeType>
+typename OrderStatisticTree<T, Comparator, NodeType>::iterator
+OrderStatisticTree<T, Comparator, NodeType>::nth(std::size_t index) {
+  return iterator(nth_node(index));
+}
+
+template<typename T, typename Comparator, typename NodeType>
+typename OrderStatisticTree<T, Comparator, NodeType>::const_iterator
+OrderStatisticTree<T, Comparator, NodeType>::nth(std::size_t index) const {
+  return const_iterator(nth_node(index));
+}
+
+template<typename T, typename Comparator, typename NodeType>
+std::size_t OrderStatisticTree<T, Comparator, NodeType>::rank(value_type const &value) const {
+  std::size_t res = 0;
+  auto node = this->root();
+  while (node) {
+    if (this->comparator()(node->data(), value)) {
+      res += NodeType::size(node->left()) + 1;
+      node = node->right();
+    } else {
+      node = node->left();
+    }
+  }
+  return res;
+}
+
+template<typename T, typename Comparator, typename NodeType>
+std::size_t OrderStatisticTree<T, Comparator, NodeType>::rank(const_iterator position) const {
+  auto node = this->current(position);
+  if (!node)
+    return this->size();
+  auto res = NodeType::size(node->left());
+  for (; node->parent(); node = node->parent()) {
+    if (node->parent()->child_is_right(node))
+      res += NodeType::size(node->parent()->left()) + 1;
+  }
+  return res;
+}
+
+template<typename T, typename Comparator, typename NodeType>
+typename OrderStatisticTree<T, Comparator, NodeType>::iterator
+OrderStatisticTree<T, Comparator, NodeType>::advance(const_iterator position,
+                                                     std::ptrdiff_t offset) {
+  auto index = static_cast<std::ptrdiff_t>(rank(position)) + offset;
+  if (index < 0)
+    return this->end();
+  return nth(static_cast<std::size_t>(index));
+}
+
+}
+#endif
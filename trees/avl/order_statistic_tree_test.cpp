@@ -0,0 +1,112 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <trees/avl/order_statistic_tree.h>
+#include <trees/avl/order_statistic_tree.ipp>
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace trees::avl::test {
+
+TEST(OrderStatisticTree, nth_and_rank_small) {
+  OrderStatisticTree<int> tree;
+  for (auto value : {50, 20, 80, 10, 30, 70, 90, 60})
+    tree.insert(value);
+  std::vector<int> expected{10, 20, 30, 50, 60, 70, 80, 90};
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(*tree.nth(i), expected[i]);
+    EXPECT_EQ(tree.rank(expected[i]), i);
+    EXPECT_EQ(tree.rank(tree.find(expected[i])), i);
+  }
+  EXPECT_EQ(tree.nth(8), tree.end());
+  EXPECT_EQ(tree.rank(55), 4);
+  EXPECT_EQ(tree.rank(100), 8);
+  EXPECT_EQ(tree.rank(tree.end()), 8);
+  EXPECT_EQ(*tree.advance(tree.find(20), 3), 60);
+  EXPECT_EQ(*tree.advance(tree.find(60), -3), 20);
+  EXPECT_EQ(tree.advance(tree.find(60), 4), tree.end());
+  EXPECT_EQ(tree.advance(tree.find(20), -2), tree.end());
+}
+
+TEST(OrderStatisticTree, random_insert_and_erase_matches_set) {
+  std::default_random_engine generator(42);
+  std::uniform_int_distribution<int> distribution(0, 5000);
+  OrderStatisticTree<int> tree;
+  std::set<int> numbers_set;
+  for (int i = 0; i < 20000; ++i) {
+    auto number = distribution(generator);
+    if (i % 3 == 2) {
+      tree.erase(number);
+      numbers_set.erase(number);
+    } else {
+      tree.insert(number);
+      numbers_set.insert(number);
+    }
+  }
+  ASSERT_EQ(tree.size(), numbers_set.size());
+  std::vector<int> numbers(numbers_set.begin(), numbers_set.end());
+  for (std::size_t i = 0; i < numbers.size(); ++i) {
+    ASSERT_EQ(*tree.nth(i), numbers[i]);
+    ASSERT_EQ(tree.rank(numbers[i]), i);
+  }
+}
+
+TEST(OrderStatisticTree, assign_sorted_keeps_sizes) {
+  std::vector<int> numbers(1000);
+  for (int i = 0; i < 1000; ++i)
+    numbers[i] = 2 * i;
+  OrderStatisticTree<int> tree{numbers.begin(), numbers.end()};
+  EXPECT_EQ(*tree.nth(990), 1980);
+  EXPECT_EQ(tree.rank(1001), 501);
+  tree.insert(1001);
+  EXPECT_EQ(*tree.nth(501), 1001);
+  OrderStatisticTree<int> copy_tree{tree};
+  EXPECT_EQ(tree, copy_tree);
+}
+
+// Subtree sizes let split read both part sizes off the roots; they must agree with the contents.
+TEST(OrderStatisticTree, split_sizes_from_subtree_counts) {
+  for (int key : {-1, 0, 1, 377, 500, 999, 1000, 1500}) {
+    std::vector<int> numbers(1000);
+    for (int i = 0; i < 1000; ++i)
+      numbers[i] = i;
+    OrderStatisticTree<int> tree{numbers.begin(), numbers.end()};
+    auto right = tree.split(key);
+    auto kept = static_cast<std::size_t>(std::clamp(key, 0, 1000));
+    ASSERT_EQ(tree.size(), kept);
+    ASSERT_EQ(right.size(), 1000 - kept);
+    EXPECT_EQ(static_cast<std::size_t>(std::distance(tree.begin(), tree.end())), kept);
+    EXPECT_EQ(static_cast<std::size_t>(std::distance(right.begin(), right.end())), 1000 - kept);
+    if (kept > 0) {
+      EXPECT_EQ(*tree.nth(kept - 1), static_cast<int>(kept) - 1);
+      EXPECT_EQ(tree.rank(key), kept);
+    }
+  }
+}
+
+}
@@ -0,0 +1,129 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_AVL_PERSISTENT_AVL_TREE_H_
+#define ALGORITHMS_TREES_AVL_PERSISTENT_AVL_TREE_H_
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace trees::avl {
+
+// AVL set whose nodes are immutable and shared between versions. An update copies only the
+// O(log n) nodes on its search path (plus those a rotation touches) and shares every other
+// subtree, so copying the tree is O(1) and yields a snapshot later updates cannot disturb.
+// Reference counts are atomic, so snapshots can be read on other threads.
+template<typename T, typename Comparator = std::less<T>>
+class PersistentAVLTree {
+  struct Node;
+  using NodePointer = std::shared_ptr<Node const>;
+
+ public:
+  using value_type = T;
+
+  explicit PersistentAVLTree(Comparator comp = Comparator());
+  PersistentAVLTree(PersistentAVLTree const &src) = default;
+  PersistentAVLTree(PersistentAVLTree &&src) noexcept = default;
+  PersistentAVLTree &operator=(PersistentAVLTree const &src) = default;
+  PersistentAVLTree &operator=(PersistentAVLTree &&src) noexcept = default;
+
+  // Iterators keep the path from the root, as nodes have no parent pointers. They remain valid
+  // as long as some tree still holds the version they were taken from.
+  class const_iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T const;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T const *;
+    using reference = T const &;
+
+    const_iterator() = default;
+
+    const_iterator &operator++();
+    const_iterator operator++(int);
+    const_iterator &operator--();
+    const_iterator operator--(int);
+    [[nodiscard]] bool operator==(const const_iterator &other) const;
+    [[nodiscard]] bool operator!=(const const_iterator &other) const;
+    [[nodiscard]] reference operator*() const;
+
+   private:
+    friend class PersistentAVLTree;
+
+    Node const *root_ = nullptr;
+    std::vector<Node const *> path_;
+
+    explicit const_iterator(Node const *root) : root_{root} {}
+    void push_leftmost(Node const *node);
+    void push_rightmost(Node const *node);
+  };
+  using iterator = const_iterator;
+
+  [[nodiscard]] const_iterator begin() const;
+  [[nodiscard]] inline const_iterator end() const { return const_iterator(root_.get()); }
+
+  // Returns a tree sharing every node with this one, in O(1).
+  [[nodiscard]] inline PersistentAVLTree snapshot() const { return *this; }
+
+  bool insert(value_type value);
+  std::size_t erase(value_type const &value);
+  inline void clear() {
+    root_.reset();
+    size_ = 0;
+  }
+
+  [[nodiscard]] inline std::size_t size() const { return size_; }
+  [[nodiscard]] inline bool empty() const { return size_ == 0; }
+  [[nodiscard]] inline std::size_t height() const { return root_ ? root_->height - 1 : 0; }
+  [[nodiscard]] const_iterator find(value_type const &value) const;
+  [[nodiscard]] const_iterator lower_bound(value_type const &value) const;
+  [[nodiscard]] bool contains(value_type const &value) const;
+
+  [[nodiscard]] bool operator==(PersistentAVLTree const &other) const;
+
+ private:
+  struct Node {
+    T value;
+    NodePointer left;
+    NodePointer right;
+    int height;
+  };
+
+  Comparator comp_;
+  NodePointer root_;
+  std::size_t size_;
+
+  static inline int height(NodePointer const &node) { return node ? node->height : 0; }
+  static NodePointer make(T value, NodePointer left, NodePointer right);
+  static NodePointer balance(T const &value, NodePointer left, NodePointer right);
+  NodePointer insert(NodePointer const &node, T &value, bool &inserted) const;
+  NodePointer erase(NodePointer const &node, T const &value, bool &erased) const;
+  static NodePointer erase_min(NodePointer const &node);
+};
+
+}
+#endif //ALGORITHMS_TREES_AVL_PERSISTENT_AVL_TREE_H_
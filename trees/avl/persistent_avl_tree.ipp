@@ -0,0 +1,276 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_AVL_PERSISTENT_AVL_TREE_IPP_
+#define ALGORITHMS_TREES_AVL_PERSISTENT_AVL_TREE_IPP_
+
+#include <algorithm>
+#include <trees/avl/persistent_avl_tree.h>
+
+namespace trees::avl {
+
+template<typename T, typename Comparator>
+void PersistentAVLTree<T, Comparator>::const_iterator::push_leftmost(Node const *node) {
+  for (; node; node = node->left.get())
+    path_.push_back(node);
+}
+
+template<typename T, typename Comparator>
+void PersistentAVLTree<T, Comparator>::const_iterator::push_rightmost(Node const *node) {
+  for (; node; node = node->right.get())
+    path_.push_back(node);
+}
+
+template<typename T, typename Comparator>
+typename PersistentAVLTree<T, Comparator>::const_iterator &
+PersistentAVLTree<T, Comparator>::const_iterator::operator++() {
+  auto node = path_.back();
+  if (node->right) {
+    push_leftmost(node->right.get());
+    return *this;
+  }
+  path_.pop_back();
+  while (!path_.empty() && path_.back()->right.get() == node) {
+    node = path_.back();
+    path_.pop_back();
+  }
+  return *this;
+}
+
+template<typename T, typename Comparator>
+typename PersistentAVLTree<T, Comparator>::const_iterator
+PersistentAVLTree<T, Comparator>::const_iterator::operator++(int) {
+  const_iterator retval = *this;
+  ++(*this);
+  return retval;
+}
+
+template<typename T, typename Comparator>
+typename PersistentAVLTree<T, Comparator>::const_iterator &
+PersistentAVLTree<T, Comparator>::const_iterator::operator--() {
+  if (path_.empty()) {
+    push_rightmost(root_);
+    return *this;
+  }
+  auto node = path_.back();
+  if (node->left) {
+    push_rightmost(node->left.get());
+    return *this;
+  }
+  path_.pop_back();
+  while (!path_.empty() && path_.back()->left.get() == node) {
+    node = path_.back();
+    path_.pop_back();
+  }
+  return *this;
+}
+
+template<typename T, typename Comparator>
+typename PersistentAVLTree<T, Comparator>::const_iterator
+PersistentAVLTree<T, Comparator>::const_iterator::operator--(int) {
+  const_iterator retval = *this;
+  --(*this);
+  return retval;
+}
+
+template<typename T, typename Comparator>
+bool PersistentAVLTree<T, Comparator>::const_iterator::operator==(const const_iterator &other) const {
+  if (path_.empty() || other.path_.empty())
+    return path_.empty() && other.path_.empty();
+  return path_.back() == other.path_.back();
+}
+
+template<typename T, typename Comparator>
+bool PersistentAVLTree<T, Comparator>::const_iterator::operator!=(const const_iterator &other) const {
+  return !(*this == other);
+}
+
+template<typename T, typename Comparator>
+typename PersistentAVLTree<T, Comparator>::const_iterator::reference
+PersistentAVLTree<T, Comparator>::const_iterator::operator*() const {
+  return path_.back()->value;
+}
+
+template<typename T, typename Comparator>
+PersistentAVLTree<T, Comparator>::PersistentAVLTree(Comparator comp) : comp_{comp}, root_{nullptr}, size_{0} {}
+
+template<typename T, typename Comparator>
+typename PersistentAVLTree<T, Comparator>::const_iterator PersistentAVLTree<T, Comparator>::begin() const {
+  const_iterator res(root_.get());
+  res.push_leftmost(root_.get());
+  return res;
+}
+
+template<typename T, typename Comparator>
+typename PersistentAVLTree<T, Comparator>::const_iterator
+PersistentAVLTree<T, Comparator>::lower_bound(value_type const &value) const {
+  const_iterator res(root_.get());
+  std::size_t depth = 0;
+  for (auto node = root_.get(); node;) {
+    res.path_.push_back(node);
+    if (comp_(node->value, value)) {
+      node = node->right.get();
+    } else {
+      depth = res.path_.size();
+      node = node->left.get();
+    }
+  }
+  // The answer is the last node where the search went left; its ancestors are the path above it.
+  res.path_.resize(depth);
+  return res;
+}
+
+template<typename T, typename Comparator>
+typename PersistentAVLTree<T, Comparator>::const_iterator
+PersistentAVLTree<T, Comparator>::find(value_type const &value) const {
+  auto res = lower_bound(value);
+  if (res == end() || comp_(value, *res))
+    return end();
+  return res;
+}
+
+template<typename T, typename Comparator>
+bool PersistentAVLTree<T, Comparator>::contains(value_type const &value) const {
+  auto node = root_.get();
+  while (node) {
+    if (comp_(value, node->value))
+      node = node->left.get();
+    else if (comp_(node->value, value))
+      node = node->right.get();
+    else
+      return true;
+  }
+  return false;
+}
+
+template<typename T, typename Comparator>
+bool PersistentAVLTree<T, Comparator>::insert(value_type value) {
+  bool inserted = false;
+  auto root = insert(root_, value, inserted);
+  if (inserted) {
+    root_ = std::move(root);
+    ++size_;
+  }
+  return inserted;
+}
+
+template<typename T, typename Comparator>
+std::size_t PersistentAVLTree<T, Comparator>::erase(value_type const &value) {
+  bool erased = false;
+  auto root = erase(root_, value, erased);
+  if (!erased)
+    return 0;
+  root_ = std::move(root);
+  --size_;
+  return 1;
+}
+
+template<typename T, typename Comparator>
+bool PersistentAVLTree<T, Comparator>::operator==(PersistentAVLTree const &other) const {
+  if (root_ == other.root_)
+    return true;
+  return size() == other.size() && std::equal(begin(), end(), other.begin());
+}
+
+template<typename T, typename Comparator>
+typename PersistentAVLTree<T, Comparator>::NodePointer
+PersistentAVLTree<T, Comparator>::make(T value, NodePointer left, NodePointer right) {
+  auto height = 1 + std::max(PersistentAVLTree::height(left), PersistentAVLTree::height(right));
+  return std::make_shared<Node const>(Node{std::move(value), std::move(left), std::move(right), height});
+}
+
+// Builds the node for value over left and right, whose heights differ by at most two, rotating
+// when they differ by two. Shared nodes are never modified; a rotation copies the ones it moves.
+template<typename T, typename Comparator>
+typename PersistentAVLTree<T, Comparator>::NodePointer
+PersistentAVLTree<T, Comparator>::balance(T const &value, NodePointer left, NodePointer right) {
+  if (height(left) > height(right) + 1) {
+    if (height(left->left) >= height(left->right))
+      return make(left->value, left->left, make(value, left->right, std::move(right)));
+    auto const &middle = left->right;
+    return make(middle->value, make(left->value, left->left, middle->left),
+                make(value, middle->right, std::move(right)));
+  }
+  if (height(right) > height(left) + 1) {
+    if (height(right->right) >= height(right->left))
+      return make(right->value, make(value, std::move(left), right->left), right->right);
+    auto const &middle = right->left;
+    return make(middle->value, make(value, std::move(left), middle->left),
+                make(right->value, middle->right, right->right));
+  }
+  return make(value, std::move(left), std::move(right));
+}
+
+template<typename T, typename Comparator>
+typename PersistentAVLTree<T, Comparator>::NodePointer
+PersistentAVLTree<T, Comparator>::insert(NodePointer const &node, T &value, bool &inserted) const {
+  if (!node) {
+    inserted = true;
+    return make(std::move(value), nullptr, nullptr);
+  }
+  if (comp_(value, node->value)) {
+    auto left = insert(node->left, value, inserted);
+    return inserted ? balance(node->value, std::move(left), node->right) : node;
+  }
+  if (comp_(node->value, value)) {
+    auto right = insert(node->right, value, inserted);
+    return inserted ? balance(node->value, node->left, std::move(right)) : node;
+  }
+  return node;
+}
+
+template<typename T, typename Comparator>
+typename PersistentAVLTree<T, Comparator>::NodePointer
+PersistentAVLTree<T, Comparator>::erase(NodePointer const &node, T const &value, bool &erased) const {
+  if (!node)
+    return node;
+  if (comp_(value, node->value)) {
+    auto left = erase(node->left, value, erased);
+    return erased ? balance(node->value, std::move(left), node->right) : node;
+  }
+  if (comp_(node->value, value)) {
+    auto right = erase(node->right, value, erased);
+    return erased ? balance(node->value, node->left, std::move(right)) : node;
+  }
+  erased = true;
+  if (!node->left)
+    return node->right;
+  if (!node->right)
+    return node->left;
+  auto min = node->right.get();
+  while (min->left)
+    min = min->left.get();
+  return balance(min->value, node->left, erase_min(node->right));
+}
+
+template<typename T, typename Comparator>
+typename PersistentAVLTree<T, Comparator>::NodePointer
+PersistentAVLTree<T, Comparator>::erase_min(NodePointer const &node) {
+  if (!node->left)
+    return node->right;
+  return balance(node->value, erase_min(node->left), node->right);
+}
+
+}
+#endif
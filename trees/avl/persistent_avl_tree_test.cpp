@@ -0,0 +1,138 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <trees/avl/persistent_avl_tree.h>
+#include <trees/avl/persistent_avl_tree.ipp>
+#include <trees/avl/avl_tree.h>
+#include <trees/avl/avl_tree.ipp>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace trees::avl::test {
+
+TEST(PersistentAVLTree, random_insert_and_erase_matches_set) {
+  std::default_random_engine generator(13);
+  std::uniform_int_distribution<int> distribution(0, 4000);
+  PersistentAVLTree<int> tree;
+  std::set<int> numbers_set;
+  for (int i = 0; i < 20000; ++i) {
+    auto number = distribution(generator);
+    if (i % 3 == 2)
+      EXPECT_EQ(tree.erase(number), numbers_set.erase(number));
+    else
+      EXPECT_EQ(tree.insert(number), numbers_set.insert(number).second);
+    ASSERT_EQ(tree.size(), numbers_set.size());
+  }
+  EXPECT_TRUE(std::equal(tree.begin(), tree.end(), numbers_set.begin(), numbers_set.end()));
+  EXPECT_LE(tree.height(), 1.44 * std::log2(numbers_set.size() + 2));
+  std::vector<int> reversed;
+  for (auto itr = tree.end(); itr != tree.begin();)
+    reversed.push_back(*--itr);
+  EXPECT_TRUE(std::equal(reversed.begin(), reversed.end(), numbers_set.rbegin(), numbers_set.rend()));
+  for (int key = -1; key <= 4001; ++key) {
+    EXPECT_EQ(tree.contains(key), numbers_set.count(key) == 1);
+    auto expected = numbers_set.lower_bound(key);
+    auto found = tree.lower_bound(key);
+    if (expected == numbers_set.end())
+      EXPECT_EQ(found, tree.end());
+    else
+      EXPECT_EQ(*found, *expected);
+    EXPECT_EQ(tree.find(key) != tree.end(), numbers_set.count(key) == 1);
+  }
+}
+
+TEST(PersistentAVLTree, snapshots_are_unaffected_by_updates) {
+  PersistentAVLTree<std::string> tree;
+  std::vector<PersistentAVLTree<std::string>> snapshots;
+  std::vector<std::set<std::string>> expected;
+  std::set<std::string> current;
+  std::default_random_engine generator(3);
+  std::uniform_int_distribution<int> distribution(0, 300);
+  for (int i = 0; i < 3000; ++i) {
+    auto key = std::to_string(distribution(generator));
+    if (i % 4 == 3) {
+      tree.erase(key);
+      current.erase(key);
+    } else {
+      tree.insert(key);
+      current.insert(key);
+    }
+    if (i % 250 == 0) {
+      snapshots.push_back(tree.snapshot());
+      expected.push_back(current);
+    }
+  }
+  for (std::size_t i = 0; i < snapshots.size(); ++i) {
+    EXPECT_EQ(snapshots[i].size(), expected[i].size());
+    EXPECT_TRUE(std::equal(snapshots[i].begin(), snapshots[i].end(), expected[i].begin(), expected[i].end()));
+  }
+  auto itr = tree.find(*current.begin());
+  auto snapshot = tree.snapshot();
+  EXPECT_EQ(snapshot, tree);
+  tree.clear();
+  EXPECT_EQ(*itr, *current.begin());
+  EXPECT_FALSE(snapshot == tree);
+}
+
+TEST(PersistentAVLTree, benchmark_snapshot_vs_copy) {
+  std::size_t size = 1 << 18;
+  std::vector<unsigned int> numbers(size);
+  std::iota(numbers.begin(), numbers.end(), 0);
+  AVLTree<unsigned int> avl_tree{numbers.begin(), numbers.end()};
+  PersistentAVLTree<unsigned int> tree;
+  for (auto number : numbers)
+    tree.insert(number);
+
+  auto start = std::chrono::high_resolution_clock::now();
+  std::vector<AVLTree<unsigned int>> copies;
+  for (unsigned int i = 0; i < 10; ++i) {
+    copies.push_back(avl_tree);
+    avl_tree.erase(2 * i);
+  }
+  auto finish = std::chrono::high_resolution_clock::now();
+  auto copy_us = std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+
+  start = std::chrono::high_resolution_clock::now();
+  std::vector<PersistentAVLTree<unsigned int>> snapshots;
+  for (unsigned int i = 0; i < 10; ++i) {
+    snapshots.push_back(tree.snapshot());
+    tree.erase(2 * i);
+  }
+  finish = std::chrono::high_resolution_clock::now();
+  auto snapshot_us = std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+
+  EXPECT_EQ(snapshots.front().size(), size);
+  EXPECT_EQ(tree.size(), size - 10);
+  EXPECT_TRUE(std::equal(tree.begin(), tree.end(), avl_tree.begin(), avl_tree.end()));
+  std::cout << "10 copies and erases: AVLTree " << copy_us << "us PersistentAVLTree " << snapshot_us << "us"
+            << std::endl;
+}
+
+}
@@ -26,36 +26,65 @@ SOFTWARE.
 #define ALGORITHMS_TREES_BST_HXX_
 
 #include <memory>
+#include <optional>
+#include <span>
 #include <stack>
+#include <utility>
+#include <vector>
+#include <trees/node_allocator.h>
 
 namespace trees {
 
 namespace detail {
 
-template<typename T>
+template<typename Comparator>
+concept transparent_comparator = requires { typename Comparator::is_transparent; };
+
+inline void prefetch(void const *address) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address);
+#endif
+}
+
+template<typename T, template<typename> class Allocator = HeapNodeAllocator>
 struct BSTNodeTraits;
 
 template<typename T, typename NodeTraits = trees::detail::BSTNodeTraits<T>>
 class BSTNode {
   using NodeType = typename NodeTraits::NodeType;
  public:
+  using value_type = T;
+  using allocator_type = typename NodeTraits::allocator_type;
+  using pointer = typename allocator_type::pointer;
+
+  // Nodes carrying data derived from their subtree set this and shadow update_augmented, which
+  // trees call bottom-up whenever the children of a node change.
+  static constexpr bool is_augmented = false;
+  // Nodes that keep their subtree size in size() set this, so trees can count a detached part
+  // from its root instead of walking it.
+  static constexpr bool has_subtree_size = false;
+
   inline explicit BSTNode(T &&data,
                           NodeType *parent = nullptr,
-                          std::unique_ptr<NodeType> left = nullptr,
-                          std::unique_ptr<NodeType> right = nullptr) : data_{std::forward<T>(data)},
+                          pointer left = nullptr,
+                          pointer right = nullptr) : data_{std::forward<T>(data)},
                                                                        parent_{parent},
                                                                        left_{std::move(left)},
                                                                        right_{std::move(right)} {
   }
 
+  // Builds data in place from args, for payloads that should not be constructed before the tree
+  // knows it will keep them.
+  template<typename... Args>
+  inline explicit BSTNode(std::in_place_t, NodeType *parent, Args &&... args)
+      : data_(std::forward<Args>(args)...), parent_{parent}, left_{nullptr}, right_{nullptr} {}
+
   inline BSTNode(BSTNode const &src,
                  NodeType *parent)
       : data_{src.data_},
         parent_{parent},
-        left_{src.left() ? std::make_unique<NodeType>(*src.left(), get_this()) : nullptr},
-        right_{src.right() ? std::make_unique<NodeType>(*src.right(), get_this()) : nullptr} {}
-
-  virtual ~BSTNode() { }
+        left_{src.left() ? allocator_type::make_near(get_this(), *src.left(), get_this()) : nullptr},
+        right_{src.right() ? allocator_type::make_near(get_this(), *src.right(), get_this()) : nullptr} {}
 
   inline T const &data() const { return data_; }
   inline T &data() { return data_; }
@@ -66,17 +95,17 @@ class BSTNode {
   inline NodeType *right() const { return right_.get(); }
   inline NodeType *parent() const { return parent_; }
 
-  inline std::unique_ptr<NodeType> &&left_move() { return std::move(left_); }
-  inline std::unique_ptr<NodeType> &&right_move() { return std::move(right_); }
+  inline pointer &&left_move() { return std::move(left_); }
+  inline pointer &&right_move() { return std::move(right_); }
 
-  inline void replace_child(NodeType *child, std::unique_ptr<NodeType> new_child) {
+  inline void replace_child(NodeType *child, pointer new_child) {
     if (this->child_is_left(child))
       left(new_child);
     else if (this->child_is_right(child))
       right(new_child);
   }
 
-  inline std::unique_ptr<NodeType> &&child_move(NodeType *child) {
+  inline pointer &&child_move(NodeType *child) {
     if (this->child_is_left(child)) {
       return left_move();
     } else if (this->child_is_right(child))
@@ -99,12 +128,12 @@ class BSTNode {
     return res;
   }
 
-  inline void left(std::unique_ptr<NodeType> node) {
+  inline void left(pointer node) {
     left_ = std::move(node);
     if (left_)
       left_->parent(get_this());
   }
-  inline void right(std::unique_ptr<NodeType> node) {
+  inline void right(pointer node) {
     right_ = std::move(node);
     if (right_)
       right_->parent(get_this());
@@ -115,15 +144,26 @@ class BSTNode {
   }
 
   inline NodeType *add_left(T &&data) {
-    left_ = std::make_unique<NodeType>(std::forward<T>(data), get_this());
+    left_ = allocator_type::make_near(get_this(), std::forward<T>(data), get_this());
     return left_.get();
   }
 
   inline NodeType *add_right(T &&data) {
-    right_ = std::make_unique<NodeType>(std::forward<T>(data), get_this());
+    right_ = allocator_type::make_near(get_this(), std::forward<T>(data), get_this());
     return right_.get();
   }
 
+  template<typename... Args>
+  inline NodeType *emplace_child(int offset, Args &&... args) {
+    auto node = allocator_type::make_near(get_this(), std::in_place, get_this(), std::forward<Args>(args)...);
+    auto res = node.get();
+    if (offset < 0)
+      left_ = std::move(node);
+    else
+      right_ = std::move(node);
+    return res;
+  }
+
   [[nodiscard]] inline bool child_is_left(NodeType const *child) const {
     return left_.get() == child;
   }
@@ -131,21 +171,29 @@ class BSTNode {
     return right_.get() == child;
   }
 
+  // Walks the subtree with an explicit stack, since a degenerate tree is as deep as it is large.
   [[nodiscard]] inline std::size_t height() const {
-    std::size_t loffset = 0;
-    if (this->left())
-      loffset = 1 + this->left()->height();
-    std::size_t roffset = 0;
-    if (this->right())
-      roffset = 1 + this->right()->height();
-    return std::max(loffset, roffset);
+    std::size_t res = 0;
+    std::vector<std::pair<NodeType const *, std::size_t>> pending{{static_cast<NodeType const *>(this), 0}};
+    while (!pending.empty()) {
+      auto[node, depth] = pending.back();
+      pending.pop_back();
+      res = std::max(res, depth);
+      if (node->left())
+        pending.emplace_back(node->left(), depth + 1);
+      if (node->right())
+        pending.emplace_back(node->right(), depth + 1);
+    }
+    return res;
   }
 
   [[nodiscard]] inline NodeType *child(int offset) const {
     return (offset == -1) ? left() : (offset == 1) ? right() : nullptr;
   }
 
-  [[nodiscard]] inline virtual bool operator==(NodeType const &other) const {
+  inline void update_augmented() {}
+
+  [[nodiscard]] inline bool operator==(NodeType const &other) const {
     bool left_match = compare(left(), other.left());
     if (!left_match) return false;
     bool right_match = compare(right(), other.right());
@@ -156,8 +204,8 @@ class BSTNode {
  private:
   T data_;
   NodeType *parent_;
-  std::unique_ptr<NodeType> left_;
-  std::unique_ptr<NodeType> right_;
+  pointer left_;
+  pointer right_;
 
   NodeType *get_this() {
     return static_cast<NodeType *>(this);
@@ -173,26 +221,97 @@ class BSTNode {
 
 };
 
-template<typename T>
+template<typename T, template<typename> class Allocator>
 struct BSTNodeTraits {
   using NodeType = typename trees::detail::BSTNode<T, BSTNodeTraits>;
+  using allocator_type = Allocator<NodeType>;
+};
+
+template<typename T, template<typename> class Allocator = HeapNodeAllocator>
+struct HeightCachedBSTNodeTraits;
+
+// Caches the height of its subtree, making height O(1) at the cost of refreshing every ancestor
+// on insert and erase, which walk that path anyway.
+template<typename T, typename NodeTraits = trees::detail::HeightCachedBSTNodeTraits<T>>
+class HeightCachedBSTNode : public BSTNode<T, NodeTraits> {
+  using NodeType = typename NodeTraits::NodeType;
+ public:
+  using pointer = typename BSTNode<T, NodeTraits>::pointer;
+
+  static constexpr bool is_augmented = true;
+
+  inline explicit HeightCachedBSTNode(T &&data,
+                                      NodeType *parent = nullptr,
+                                      pointer left = nullptr,
+                                      pointer right = nullptr)
+      : BSTNode<T, NodeTraits>(std::forward<T>(data), parent, std::move(left), std::move(right)),
+        height_{0} {}
+
+  inline HeightCachedBSTNode(HeightCachedBSTNode const &src, NodeType *parent)
+      : BSTNode<T, NodeTraits>(src, parent), height_{src.height_} {}
+
+  [[nodiscard]] inline std::size_t height() const { return height_; }
+
+  inline void update_augmented() {
+    std::size_t left_height = this->left() ? 1 + this->left()->height() : 0;
+    std::size_t right_height = this->right() ? 1 + this->right()->height() : 0;
+    height_ = std::max(left_height, right_height);
+  }
 
+ private:
+  std::size_t height_;
+};
+
+template<typename T, template<typename> class Allocator>
+struct HeightCachedBSTNodeTraits {
+  using NodeType = typename trees::detail::HeightCachedBSTNode<T, HeightCachedBSTNodeTraits>;
+  using allocator_type = Allocator<NodeType>;
 };
 
 }
 
+template<typename Iterator>
+class IteratorRange {
+ public:
+  inline IteratorRange(Iterator first, Iterator last) : first_{first}, last_{last} {}
+
+  [[nodiscard]] inline Iterator begin() const { return first_; }
+  [[nodiscard]] inline Iterator end() const { return last_; }
+  [[nodiscard]] inline bool empty() const { return first_ == last_; }
+
+ private:
+  Iterator first_;
+  Iterator last_;
+};
+
+struct TreeShape {
+  std::size_t size;
+  std::size_t height;
+  // Height of a perfectly balanced tree of the same size, the least height possible.
+  std::size_t min_height;
+};
+
 template<typename T, typename Comparator = std::less<T>, typename NodeType = detail::BSTNode<T>>
 class BST {
  public:
   using value_type = T;
+  using allocator_type = typename NodeType::allocator_type;
 
   inline explicit BST(Comparator comp = Comparator()) : comp_{comp}, size_{0} {}
-  inline BST(BST &&src) noexcept: comp_{src.comp_}, size_{src.size_}, root_{std::move(src.root_)} {}
+  inline BST(BST &&src) noexcept: comp_{src.comp_},
+                                  size_{src.size_},
+                                  allocator_{std::move(src.allocator_)},
+                                  root_{std::move(src.root_)},
+                                  leftmost_{std::exchange(src.leftmost_, nullptr)},
+                                  rightmost_{std::exchange(src.rightmost_, nullptr)} {
+    src.size_ = 0;
+  }
   inline BST(BST const &src) : comp_{src.comp_},
                                size_{src.size_},
-                               root_{(src.root()) ? std::make_unique<NodeType>(*src.root(), nullptr)
+                               allocator_{},
+                               root_{(src.root()) ? allocator_.make(*src.root(), nullptr)
                                                   : nullptr} {}
-  inline virtual ~BST() = default;
+  inline virtual ~BST() { allocator_.clear(std::move(root_)); }
 
   template<bool is_const = true>
   class base_iterator {
@@ -206,6 +325,7 @@ class BST {
     using reference = std::conditional_t<is_const, T const &, T &>;
 
     inline base_iterator(base_iterator<false> const &src) : base_iterator{src.current()} {}
+    base_iterator &operator=(base_iterator const &) = default;
 
     explicit base_iterator(tree_type *bst);
     explicit base_iterator(NodeType *node);
@@ -217,6 +337,7 @@ class BST {
     [[nodiscard]] bool operator==(const base_iterator &other) const;
     [[nodiscard]] bool operator!=(const base_iterator &other) const;
     [[nodiscard]] reference operator*();
+    [[nodiscard]] inline pointer operator->() { return &current_->data(); }
 
    protected:
     NodeType *current() const { return current_; }
@@ -245,17 +366,81 @@ class BST {
   [[nodiscard]] inline const_iterator end() const { return const_iterator(); }
 
   virtual std::pair<iterator, bool> insert(value_type value);
+  // Inserts value next to hint when it belongs there, typically end() or the previous insertion
+  // for sorted input, costing a few comparisons instead of a search from the root. Falls back to
+  // a plain insert otherwise. Returns the element equal to value.
+  virtual iterator insert(const_iterator hint, value_type value);
+  template<typename... Args>
+  inline iterator emplace_hint(const_iterator hint, Args &&... args) {
+    return insert(hint, value_type(std::forward<Args>(args)...));
+  }
 
   virtual iterator erase(const_iterator position);
   std::size_t erase(value_type const &value);
-  iterator erase(const_iterator first, const_iterator last);
+  // Detaches [first, last) with two splits along the search paths of its ends and frees it in
+  // bulk, in O(height + k).
+  virtual iterator erase(const_iterator first, const_iterator last);
+  void clear();
+  // Replaces the contents with [first, last), which must be sorted and free of duplicates, built
+  // perfectly balanced in linear time without comparisons.
+  template<typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last);
 
   [[nodiscard]] inline std::size_t size() const { return size_; }
+  // Costs whatever NodeType::height costs: a walk of the whole tree for plain nodes, one path
+  // for AVL nodes and O(1) for height-cached nodes.
   [[nodiscard]] std::size_t height() const;
+  // Edges between position and the root. end() is no node and also reports 0, so callers that
+  // may hold end() must check for it first.
   [[nodiscard]] std::size_t level(const_iterator position) const;
+  // Level of the node equal to value. A missing value also reports 0; find_level tells it apart.
   [[nodiscard]] std::size_t level(value_type const &value) const;
+  // Level of the node equal to value, or nullopt when there is none.
+  [[nodiscard]] std::optional<std::size_t> find_level(value_type const &value) const;
+  [[nodiscard]] TreeShape shape() const;
   [[nodiscard]] const_iterator find(value_type const &value) const;
   [[nodiscard]] iterator find(value_type const &value);
+  [[nodiscard]] const_iterator lower_bound(value_type const &value) const;
+  [[nodiscard]] iterator lower_bound(value_type const &value);
+  [[nodiscard]] const_iterator upper_bound(value_type const &value) const;
+  [[nodiscard]] iterator upper_bound(value_type const &value);
+  [[nodiscard]] std::pair<const_iterator, const_iterator> equal_range(value_type const &value) const;
+  [[nodiscard]] std::pair<iterator, iterator> equal_range(value_type const &value);
+  // Looks up every key, storing the results in the matching slots of out. Groups of lookups
+  // descend in lockstep and prefetch their next node, so their cache misses overlap.
+  void find_batch(std::span<value_type const> keys, std::span<const_iterator> out) const;
+
+  // Lookups by any key the comparator can order against value_type, enabled for transparent
+  // comparators such as std::less<> so no value_type has to be built to search.
+  template<typename Key> requires detail::transparent_comparator<Comparator>
+  [[nodiscard]] inline const_iterator find(Key const &key) const { return const_iterator{find_node(key)}; }
+  template<typename Key> requires detail::transparent_comparator<Comparator>
+  [[nodiscard]] inline iterator find(Key const &key) { return iterator{find_node(key)}; }
+  template<typename Key> requires detail::transparent_comparator<Comparator>
+  [[nodiscard]] inline const_iterator lower_bound(Key const &key) const {
+    return const_iterator{lower_bound_node(key)};
+  }
+  template<typename Key> requires detail::transparent_comparator<Comparator>
+  [[nodiscard]] inline iterator lower_bound(Key const &key) { return iterator{lower_bound_node(key)}; }
+  template<typename Key> requires detail::transparent_comparator<Comparator>
+  [[nodiscard]] inline const_iterator upper_bound(Key const &key) const {
+    return const_iterator{upper_bound_node(key)};
+  }
+  template<typename Key> requires detail::transparent_comparator<Comparator>
+  [[nodiscard]] inline iterator upper_bound(Key const &key) { return iterator{upper_bound_node(key)}; }
+  template<typename Key> requires detail::transparent_comparator<Comparator>
+  [[nodiscard]] inline std::pair<const_iterator, const_iterator> equal_range(Key const &key) const {
+    auto[first, last] = equal_range_nodes(key);
+    return std::make_pair(const_iterator{first}, const_iterator{last});
+  }
+  template<typename Key> requires detail::transparent_comparator<Comparator>
+  [[nodiscard]] inline std::pair<iterator, iterator> equal_range(Key const &key) {
+    auto[first, last] = equal_range_nodes(key);
+    return std::make_pair(iterator{first}, iterator{last});
+  }
+  // Elements in [first, last); empty when last does not order after first.
+  [[nodiscard]] IteratorRange<const_iterator> range(value_type const &first, value_type const &last) const;
+  [[nodiscard]] IteratorRange<iterator> range(value_type const &first, value_type const &last);
 
   [[nodiscard]] inline bool operator==(BST const &other) const {
     if (!root() && !other.root()) return true;
@@ -264,27 +449,84 @@ class BST {
   }
 
  protected:
+  using NodePointer = typename NodeType::pointer;
+
   template<bool is_const> friend
   class base_iterator;
   inline NodeType *root() const { return root_.get(); };
   inline NodeType *current(const const_iterator &itr) const { return itr.current(); }
-  inline void root(std::unique_ptr<NodeType> root) { root_ = std::move(root); }
-  inline void size(std::size_t newsize) { size_ = newsize; }
-
-  std::unique_ptr<NodeType> move_node_and_replace(NodeType *node,
-                                                  std::unique_ptr<NodeType> replacement);
+  inline Comparator const &comparator() const { return comp_; }
+  inline void root(NodePointer root) {
+    root_ = std::move(root);
+    forget_extremes();
+  }
+  inline NodePointer root_move() {
+    size_ = 0;
+    forget_extremes();
+    return std::move(root_);
+  }
+  // Trees call this whenever nodes leave, so it also drops the cached extremes.
+  inline void size(std::size_t newsize) {
+    size_ = newsize;
+    forget_extremes();
+  }
+  inline allocator_type &allocator() { return allocator_; }
+
+  NodePointer move_node_and_replace(NodeType *node, NodePointer replacement);
+  void update_path_augmented(NodeType *node);
+  // Splits the subtree at root into the nodes ordered before value and the rest, without
+  // rebalancing.
+  std::pair<NodePointer, NodePointer> split_nodes(NodePointer root, value_type const &value);
+  // Frees the subtree at root one node at a time, returning how many there were.
+  static std::size_t dispose(NodePointer root);
+  // Adds value below node, or returns the node already equal to it along with false.
   std::pair<iterator, bool> insert(value_type &&value, NodeType *node);
+  // Where key belongs: the node equal to it with offset 0, or the node and side (-1 left, 1
+  // right) of the empty child slot it would fill. The node is null only for an empty tree.
+  template<typename Key>
+  [[nodiscard]] std::pair<NodeType *, int> insert_position(Key const &key) const;
+  // Builds a node from args in the slot found by insert_position, without rebalancing.
+  template<typename... Args>
+  iterator emplace_at(NodeType *parent, int offset, Args &&... args);
+  // Like insert(hint, value), but also reports whether value was added, for trees to rebalance.
+  std::pair<iterator, bool> insert_hinted(const_iterator hint, value_type &&value);
+
+  // The first and last nodes, cached so hinted inserts at either end skip the walk down the
+  // spine. A new leaf can only become an extreme as the outer child of the old one, so inserts
+  // keep the cache in O(1) and rotations never move it; anything removing or regrouping nodes
+  // drops it instead, and the next call walks down once.
+  [[nodiscard]] NodeType *leftmost_node();
+  [[nodiscard]] NodeType *rightmost_node();
+  void track_inserted(NodeType *node);
+  inline void forget_extremes() { leftmost_ = rightmost_ = nullptr; }
 
  private:
   Comparator comp_;
   std::size_t size_;
-  std::unique_ptr<NodeType> root_;
-
-  [[nodiscard]] NodeType *find_node(value_type const &value) const;
-  [[nodiscard]] NodeType *find_node(value_type const &value, NodeType *node) const;
+  allocator_type allocator_;
+  NodePointer root_;
+  NodeType *leftmost_ = nullptr;
+  NodeType *rightmost_ = nullptr;
+
+  template<typename Key>
+  [[nodiscard]] NodeType *find_node(Key const &key) const;
+  template<typename Key>
+  [[nodiscard]] NodeType *lower_bound_node(Key const &key) const;
+  template<typename Key>
+  [[nodiscard]] NodeType *upper_bound_node(Key const &key) const;
+  template<typename Key>
+  [[nodiscard]] std::pair<NodeType *, NodeType *> equal_range_nodes(Key const &key) const;
   [[nodiscard]] std::size_t height(NodeType *node) const;
+  template<typename ForwardIt>
+  NodePointer build_sorted(ForwardIt &first, std::size_t count);
 
 };
 
+template<typename T, typename Comparator = std::less<T>>
+using SlabBST = BST<T, Comparator, detail::BSTNode<T, detail::BSTNodeTraits<T, detail::SlabNodeAllocator>>>;
+
+template<typename T, typename Comparator = std::less<T>>
+using HeightCachedBST = BST<T, Comparator, detail::HeightCachedBSTNode<T>>;
+
 }
 #endif //ALGORITHMS_TREES_BST_HXX_
@@ -25,6 +25,9 @@ SOFTWARE.
 #ifndef ALGORITHMS_TREES_BST_IPP_
 #define ALGORITHMS_TREES_BST_IPP_
 
+#include <algorithm>
+#include <bit>
+#include <iterator>
 #include <trees/bst.h>
 
 namespace trees {
@@ -203,7 +206,10 @@ namespace trees {
   std::pair<typename BST<T, Comparator, NodeType>::iterator, bool> BST<T,
                                                                        Comparator,
                                                                        NodeType>::insert(value_type value) {
-    return insert(std::move(value), root());
+    auto res = insert(std::move(value), root());
+    if (res.second)
+      update_path_augmented(res.first.current());
+    return res;
   }
 
   template<typename T, typename Comparator, typename NodeType>
@@ -212,27 +218,169 @@ namespace trees {
                                                                        NodeType>::insert(value_type &&value,
                                                                                          NodeType *node) {
     if (!node) {
-      root_ = std::make_unique<NodeType>(std::forward<value_type>(value));
+      root_ = allocator_.make(std::forward<value_type>(value));
       ++size_;
+      track_inserted(root());
       return std::make_pair(iterator(root()), true);
-    } else {
-      if (!comp_(node->data(), value) && !comp_(value, node->data()))
-        return std::make_pair(iterator{}, false);
-      else if (comp_(value, node->data())) {
-        if (node->left()) return insert(std::forward<value_type>(value), node->left());
-        else {
+    }
+    while (true) {
+      if (comp_(value, node->data())) {
+        if (!node->left()) {
           auto new_node = node->add_left(std::forward<value_type>(value));
           ++size_;
+          track_inserted(new_node);
           return std::make_pair(iterator(new_node), true);
         }
-      } else {
-        if (node->right()) return insert(std::forward<value_type>(value), node->right());
-        else {
+        node = node->left();
+      } else if (comp_(node->data(), value)) {
+        if (!node->right()) {
           auto new_node = node->add_right(std::forward<value_type>(value));
           ++size_;
+          track_inserted(new_node);
           return std::make_pair(iterator(new_node), true);
         }
+        node = node->right();
+      } else {
+        return std::make_pair(iterator(node), false);
+      }
+    }
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  template<typename Key>
+  std::pair<NodeType *, int> BST<T, Comparator, NodeType>::insert_position(Key const &key) const {
+    auto node = root();
+    while (node) {
+      if (comp_(key, node->data())) {
+        if (!node->left())
+          return std::make_pair(node, -1);
+        node = node->left();
+      } else if (comp_(node->data(), key)) {
+        if (!node->right())
+          return std::make_pair(node, 1);
+        node = node->right();
+      } else {
+        return std::make_pair(node, 0);
+      }
+    }
+    return std::make_pair(nullptr, 0);
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  template<typename... Args>
+  typename BST<T, Comparator, NodeType>::iterator BST<T,
+                                                      Comparator,
+                                                      NodeType>::emplace_at(NodeType *parent,
+                                                                            int offset,
+                                                                            Args &&... args) {
+    NodeType *node;
+    if (!parent) {
+      root_ = allocator_.make(std::in_place, nullptr, std::forward<Args>(args)...);
+      node = root();
+    } else {
+      node = parent->emplace_child(offset, std::forward<Args>(args)...);
+    }
+    ++size_;
+    track_inserted(node);
+    return iterator(node);
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  typename BST<T, Comparator, NodeType>::iterator BST<T,
+                                                      Comparator,
+                                                      NodeType>::insert(const_iterator hint, value_type value) {
+    auto[itr, success] = insert_hinted(hint, std::move(value));
+    if (success)
+      update_path_augmented(itr.current());
+    return itr;
+  }
+
+  // value belongs between the in-order neighbours of the gap next to hint, and that gap is always
+  // an empty child slot of one of them: the hint itself or the extreme node of its subtree on the
+  // side of the gap. Only a neighbour without such a subtree needs a walk up to be found.
+  template<typename T, typename Comparator, typename NodeType>
+  std::pair<typename BST<T, Comparator, NodeType>::iterator, bool> BST<T,
+                                                                       Comparator,
+                                                                       NodeType>::insert_hinted(const_iterator hint,
+                                                                                                value_type &&value) {
+    if (!root())
+      return insert(std::move(value), nullptr);
+    auto node = hint.current();
+    NodeType *parent = nullptr;
+    bool left = false;
+    if (!node) {
+      auto last = rightmost_node();
+      if (comp_(last->data(), value))
+        parent = last;
+    } else if (comp_(value, node->data())) {
+      if (node->left()) {
+        auto prev = node->left()->rightmost();
+        if (comp_(prev->data(), value))
+          parent = prev;
+      } else if (node == leftmost_node()) {
+        parent = node;
+        left = true;
+      } else {
+        auto child = node;
+        while (child->parent() && child->parent()->child_is_left(child))
+          child = child->parent();
+        auto prev = child->parent();
+        if (!prev || comp_(prev->data(), value)) {
+          parent = node;
+          left = true;
+        }
+      }
+    } else if (comp_(node->data(), value)) {
+      if (node->right()) {
+        auto next = node->right()->leftmost();
+        if (comp_(value, next->data())) {
+          parent = next;
+          left = true;
+        }
+      } else if (node == rightmost_node()) {
+        parent = node;
+      } else {
+        auto child = node;
+        while (child->parent() && child->parent()->child_is_right(child))
+          child = child->parent();
+        auto next = child->parent();
+        if (!next || comp_(value, next->data()))
+          parent = node;
       }
+    } else {
+      return std::make_pair(iterator(node), false);
+    }
+    if (!parent)
+      return insert(std::move(value), root());
+    auto new_node = left ? parent->add_left(std::move(value)) : parent->add_right(std::move(value));
+    ++size_;
+    track_inserted(new_node);
+    return std::make_pair(iterator(new_node), true);
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  NodeType *BST<T, Comparator, NodeType>::leftmost_node() {
+    if (!leftmost_ && root())
+      leftmost_ = root()->leftmost();
+    return leftmost_;
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  NodeType *BST<T, Comparator, NodeType>::rightmost_node() {
+    if (!rightmost_ && root())
+      rightmost_ = root()->rightmost();
+    return rightmost_;
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  void BST<T, Comparator, NodeType>::track_inserted(NodeType *node) {
+    auto parent = node->parent();
+    if (!parent) {
+      leftmost_ = rightmost_ = node;
+    } else if (parent == leftmost_ && parent->child_is_left(node)) {
+      leftmost_ = node;
+    } else if (parent == rightmost_ && parent->child_is_right(node)) {
+      rightmost_ = node;
     }
   }
 
@@ -253,20 +401,166 @@ namespace trees {
   }
 
   template<typename T, typename Comparator, typename NodeType>
-  NodeType *BST<T, Comparator, NodeType>::find_node(value_type const &value) const {
-    return find_node(value, root());
+  template<typename Key>
+  NodeType *BST<T, Comparator, NodeType>::find_node(Key const &key) const {
+    auto node = root();
+    while (node) {
+      if (comp_(key, node->data()))
+        node = node->left();
+      else if (comp_(node->data(), key))
+        node = node->right();
+      else
+        return node;
+    }
+    return nullptr;
   }
 
   template<typename T, typename Comparator, typename NodeType>
-  NodeType *BST<T, Comparator, NodeType>::find_node(value_type const &value, NodeType *node) const {
-    if (!node)
-      return nullptr;
-    if (!comp_(node->data(), value) && !comp_(value, node->data()))
-      return node;
-    if (comp_(value, node->data()))
-      return find_node(value, node->left());
-    else
-      return find_node(value, node->right());
+  void BST<T, Comparator, NodeType>::find_batch(std::span<value_type const> keys,
+                                                std::span<const_iterator> out) const {
+    constexpr std::size_t group_size = 16;
+    auto count = std::min(keys.size(), out.size());
+    NodeType *nodes[group_size];
+    for (std::size_t first = 0; first < count; first += group_size) {
+      auto group = std::min(group_size, count - first);
+      for (std::size_t i = 0; i < group; ++i) {
+        nodes[i] = root();
+        out[first + i] = end();
+      }
+      bool active = root() != nullptr;
+      while (active) {
+        active = false;
+        for (std::size_t i = 0; i < group; ++i) {
+          auto node = nodes[i];
+          if (!node)
+            continue;
+          auto const &key = keys[first + i];
+          if (comp_(key, node->data())) {
+            node = node->left();
+          } else if (comp_(node->data(), key)) {
+            node = node->right();
+          } else {
+            out[first + i] = const_iterator{node};
+            node = nullptr;
+          }
+          if (node) {
+            detail::prefetch(node);
+            active = true;
+          }
+          nodes[i] = node;
+        }
+      }
+    }
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  template<typename Key>
+  NodeType *BST<T, Comparator, NodeType>::lower_bound_node(Key const &key) const {
+    NodeType *res = nullptr;
+    auto node = root();
+    while (node) {
+      if (!comp_(node->data(), key)) {
+        res = node;
+        node = node->left();
+      } else {
+        node = node->right();
+      }
+    }
+    return res;
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  template<typename Key>
+  NodeType *BST<T, Comparator, NodeType>::upper_bound_node(Key const &key) const {
+    NodeType *res = nullptr;
+    auto node = root();
+    while (node) {
+      if (comp_(key, node->data())) {
+        res = node;
+        node = node->left();
+      } else {
+        node = node->right();
+      }
+    }
+    return res;
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  template<typename Key>
+  std::pair<NodeType *, NodeType *> BST<T, Comparator, NodeType>::equal_range_nodes(Key const &key) const {
+    auto first = lower_bound_node(key);
+    auto last = first;
+    if (last && !comp_(key, last->data()))
+      last = (++const_iterator{last}).current();
+    return std::make_pair(first, last);
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  typename BST<T, Comparator, NodeType>::const_iterator BST<T,
+                                                            Comparator,
+                                                            NodeType>::lower_bound(value_type const &value) const {
+    return const_iterator{lower_bound_node(value)};
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  typename BST<T, Comparator, NodeType>::iterator BST<T,
+                                                      Comparator,
+                                                      NodeType>::lower_bound(value_type const &value) {
+    return iterator{lower_bound_node(value)};
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  typename BST<T, Comparator, NodeType>::const_iterator BST<T,
+                                                            Comparator,
+                                                            NodeType>::upper_bound(value_type const &value) const {
+    return const_iterator{upper_bound_node(value)};
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  typename BST<T, Comparator, NodeType>::iterator BST<T,
+                                                      Comparator,
+                                                      NodeType>::upper_bound(value_type const &value) {
+    return iterator{upper_bound_node(value)};
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  std::pair<typename BST<T, Comparator, NodeType>::const_iterator,
+            typename BST<T, Comparator, NodeType>::const_iterator> BST<T,
+                                                                       Comparator,
+                                                                       NodeType>::equal_range(value_type const &value) const {
+    auto[first, last] = equal_range_nodes(value);
+    return std::make_pair(const_iterator{first}, const_iterator{last});
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  std::pair<typename BST<T, Comparator, NodeType>::iterator,
+            typename BST<T, Comparator, NodeType>::iterator> BST<T,
+                                                                 Comparator,
+                                                                 NodeType>::equal_range(value_type const &value) {
+    auto[first, last] = equal_range_nodes(value);
+    return std::make_pair(iterator{first}, iterator{last});
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  IteratorRange<typename BST<T, Comparator, NodeType>::const_iterator> BST<T,
+                                                                           Comparator,
+                                                                           NodeType>::range(value_type const &first,
+                                                                                            value_type const &last) const {
+    auto first_itr = lower_bound(first);
+    if (!comp_(first, last))
+      return IteratorRange<const_iterator>(first_itr, first_itr);
+    return IteratorRange<const_iterator>(first_itr, lower_bound(last));
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  IteratorRange<typename BST<T, Comparator, NodeType>::iterator> BST<T,
+                                                                     Comparator,
+                                                                     NodeType>::range(value_type const &first,
+                                                                                      value_type const &last) {
+    auto first_itr = lower_bound(first);
+    if (!comp_(first, last))
+      return IteratorRange<iterator>(first_itr, first_itr);
+    return IteratorRange<iterator>(first_itr, lower_bound(last));
   }
 
   template<typename T, typename Comparator, typename NodeType>
@@ -274,15 +568,19 @@ namespace trees {
                                                       Comparator,
                                                       NodeType>::erase(const_iterator position) {
     auto node = position.current();
-    iterator itr = end();
     if (!node)
-      return itr;
+      return end();
+    // The successor is taken before any relinking, whichever children the node has.
+    auto itr = ++iterator(node);
+    // Lowest node whose children change, where augmented data starts going stale.
+    auto changed = node->parent();
     if (node->left()) {
       if (node->right()) {
-        itr = iterator(node->right()->leftmost());
+        changed = node->left();
         if (node->left()->right()) {
           auto right_leftmost = node->right()->leftmost();
           right_leftmost->left(std::move(node->left()->right_move()));
+          changed = right_leftmost;
         }
         node->left()->right(std::move(node->right_move()));
       }
@@ -293,10 +591,10 @@ namespace trees {
           node->parent()->right(std::move(node->left_move()));
       } else {
         root_ = std::move(node->left_move());
+        root_->parent(nullptr);
       }
     } else {
       if (node->right()) {
-        itr = iterator(node->right()->leftmost());
         if (node->parent()) {
           if (node->parent()->child_is_left(node))
             node->parent()->left(std::move(node->right_move()));
@@ -304,12 +602,20 @@ namespace trees {
             node->parent()->right(std::move(node->right_move()));
         } else {
           root_ = std::move(node->right_move());
+          root_->parent(nullptr);
         }
+      } else if (node->parent()) {
+        if (node->parent()->child_is_left(node))
+          node->parent()->left(nullptr);
+        else
+          node->parent()->right(nullptr);
       } else {
         root_ = nullptr;
       }
     }
     --size_;
+    forget_extremes();
+    update_path_augmented(changed);
     return itr;
   }
 
@@ -328,36 +634,140 @@ namespace trees {
                                                       Comparator,
                                                       NodeType>::erase(const_iterator first,
                                                                        const_iterator last) {
-    iterator res = end();
-    while (first != last) {
-      res = erase(first++);
+    auto last_node = last.current();
+    if (first == last)
+      return iterator(last_node);
+    auto[left, rest] = split_nodes(std::move(root_), first.current()->data());
+    NodePointer right;
+    if (last_node) {
+      auto parts = split_nodes(std::move(rest), last_node->data());
+      rest = std::move(parts.first);
+      right = std::move(parts.second);
     }
-    return res;
+    size_ -= dispose(std::move(rest));
+    if (left && right) {
+      auto node = left->rightmost();
+      node->right(std::move(right));
+      update_path_augmented(node);
+    }
+    root_ = left ? std::move(left) : std::move(right);
+    forget_extremes();
+    return iterator(last_node);
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  std::pair<typename BST<T, Comparator, NodeType>::NodePointer,
+            typename BST<T, Comparator, NodeType>::NodePointer> BST<T,
+                                                                   Comparator,
+                                                                   NodeType>::split_nodes(NodePointer root,
+                                                                                          value_type const &value) {
+    NodePointer left, right;
+    NodeType *left_tail = nullptr;
+    NodeType *right_tail = nullptr;
+    while (root) {
+      auto node = root.get();
+      if (comp_(node->data(), value)) {
+        auto next = node->right_move();
+        if (left_tail)
+          left_tail->right(std::move(root));
+        else
+          left = std::move(root);
+        left_tail = node;
+        root = std::move(next);
+      } else {
+        auto next = node->left_move();
+        if (right_tail)
+          right_tail->left(std::move(root));
+        else
+          right = std::move(root);
+        right_tail = node;
+        root = std::move(next);
+      }
+    }
+    if (left)
+      left->parent(nullptr);
+    if (right)
+      right->parent(nullptr);
+    update_path_augmented(left_tail);
+    update_path_augmented(right_tail);
+    return std::make_pair(std::move(left), std::move(right));
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  std::size_t BST<T, Comparator, NodeType>::dispose(NodePointer root) {
+    std::size_t count = 0;
+    detail::dispose_subtree(std::move(root), [&count](NodeType *node) {
+      ++count;
+      typename NodePointer::deleter_type{}(node);
+    });
+    return count;
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  void BST<T, Comparator, NodeType>::clear() {
+    allocator_.clear(std::move(root_));
+    size_ = 0;
+    forget_extremes();
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  template<typename ForwardIt>
+  void BST<T, Comparator, NodeType>::assign_sorted(ForwardIt first, ForwardIt last) {
+    clear();
+    auto count = static_cast<std::size_t>(std::distance(first, last));
+    root_ = build_sorted(first, count);
+    size_ = count;
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  template<typename ForwardIt>
+  typename BST<T, Comparator, NodeType>::NodePointer BST<T,
+                                                         Comparator,
+                                                         NodeType>::build_sorted(ForwardIt &first,
+                                                                                 std::size_t count) {
+    if (count == 0)
+      return nullptr;
+    auto left_count = (count - 1) / 2;
+    auto left = build_sorted(first, left_count);
+    auto node = allocator_.make(value_type(*first));
+    ++first;
+    node->left(std::move(left));
+    node->right(build_sorted(first, count - 1 - left_count));
+    node->update_augmented();
+    return node;
   }
 
   template<typename T, typename Comparator, typename NodeType>
-  std::unique_ptr<NodeType> BST<T,
-                                Comparator,
-                                NodeType>::move_node_and_replace(NodeType *node,
-                                                                 std::unique_ptr<NodeType> replacement) {
+  typename BST<T, Comparator, NodeType>::NodePointer BST<T,
+                                                         Comparator,
+                                                         NodeType>::move_node_and_replace(NodeType *node,
+                                                                                          NodePointer replacement) {
     if (node->parent()) {
       if (node->parent()->child_is_left(node)) {
-        std::unique_ptr<NodeType> ret = node->parent()->left_move();
+        NodePointer ret = node->parent()->left_move();
         node->parent()->left(std::move(replacement));
         return ret;
       } else {
-        std::unique_ptr<NodeType> ret = node->parent()->right_move();
+        NodePointer ret = node->parent()->right_move();
         node->parent()->right(std::move(replacement));
         return ret;
       }
     } else {
-      std::unique_ptr<NodeType> ret = std::move(root_);
+      NodePointer ret = std::move(root_);
       root_ = std::move(replacement);
       root_->parent(nullptr);
       return ret;
     }
   }
 
+  template<typename T, typename Comparator, typename NodeType>
+  void BST<T, Comparator, NodeType>::update_path_augmented(NodeType *node) {
+    if constexpr (NodeType::is_augmented) {
+      for (; node; node = node->parent())
+        node->update_augmented();
+    }
+  }
+
   template<typename T, typename Comparator, typename NodeType>
   std::size_t BST<T, Comparator, NodeType>::height() const {
     return height(root_.get());
@@ -374,8 +784,10 @@ namespace trees {
 
   template<typename T, typename Comparator, typename NodeType>
   std::size_t BST<T, Comparator, NodeType>::level(const_iterator position) const {
-    int level = 0;
+    std::size_t level = 0;
     auto node = this->current(position);
+    if (!node)
+      return level;
     while (node->parent()) {
       ++level;
       node = node->parent();
@@ -385,7 +797,30 @@ namespace trees {
 
   template<typename T, typename Comparator, typename NodeType>
   std::size_t BST<T, Comparator, NodeType>::level(value_type const &value) const {
-    return level(this->find(value));
+    return find_level(value).value_or(0);
+  }
+
+  // Counts the steps of the search itself instead of finding the node and climbing back up.
+  template<typename T, typename Comparator, typename NodeType>
+  std::optional<std::size_t> BST<T, Comparator, NodeType>::find_level(value_type const &value) const {
+    std::size_t level = 0;
+    auto node = root();
+    while (node) {
+      if (comp_(value, node->data()))
+        node = node->left();
+      else if (comp_(node->data(), value))
+        node = node->right();
+      else
+        return level;
+      ++level;
+    }
+    return std::nullopt;
+  }
+
+  template<typename T, typename Comparator, typename NodeType>
+  TreeShape BST<T, Comparator, NodeType>::shape() const {
+    auto min_height = size_ ? static_cast<std::size_t>(std::bit_width(size_)) - 1 : 0;
+    return TreeShape{size_, height(), min_height};
   }
 
 }
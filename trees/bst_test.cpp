@@ -25,8 +25,14 @@ SOFTWARE.
 #include <gtest/gtest.h>
 #include <trees/bst.h>
 #include <trees/bst.ipp>
+#include <pthread.h>
+#include <functional>
+#include <random>
+#include <set>
 #include <string>
+#include <string_view>
 #include <sstream>
+#include <vector>
 
 namespace trees::test {
 
@@ -206,6 +212,20 @@ TEST(BST, insert_and_erase_child_left_only) {
   EXPECT_EQ(print_const(bst), "1 2 3 4 ");
 }
 
+TEST(BST, insert_and_erase_child_left_only_with_successor) {
+  BST<int> bst;
+  bst.insert(1);
+  bst.insert(5);
+  bst.insert(9);
+  bst.insert(4);
+  bst.insert(2);
+  bst.insert(3);
+  auto itr = bst.find(4);
+  auto next_itr = bst.erase(itr);
+  EXPECT_EQ(*next_itr, 5);
+  EXPECT_EQ(print_const(bst), "1 2 3 5 9 ");
+}
+
 TEST(BST, insert_and_erase_root_child_right_only) {
   BST<int> bst;
   bst.insert(1);
@@ -247,5 +267,270 @@ TEST(BST, insert_and_erase_by_value) {
   EXPECT_EQ(print_const(bst), "2 4 5 6 7 8 ");
 }
 
+TEST(BST, slab_insert_erase_and_clear) {
+  SlabBST<int> bst;
+  for (auto value : {5, 3, 7, 4, 2, 6, 8})
+    bst.insert(value);
+  EXPECT_EQ(bst.erase(3), 1);
+  EXPECT_EQ(bst.erase(5), 1);
+  std::vector<int> values(bst.begin(), bst.end());
+  EXPECT_EQ(values, (std::vector<int>{2, 4, 6, 7, 8}));
+  bst.clear();
+  EXPECT_EQ(bst.size(), 0);
+  EXPECT_EQ(bst.begin(), bst.end());
+  bst.insert(1);
+  EXPECT_EQ(*bst.begin(), 1);
+}
+
+TEST(BST, slab_string_copy_and_move) {
+  SlabBST<std::string> bst;
+  for (auto value : {"e", "b", "a", "c", "g", "f", "d"})
+    bst.insert(value);
+  SlabBST<std::string> copy{bst};
+  EXPECT_EQ(copy, bst);
+  SlabBST<std::string> moved{std::move(bst)};
+  EXPECT_EQ(moved, copy);
+  moved.erase("d");
+  std::vector<std::string> values(moved.begin(), moved.end());
+  EXPECT_EQ(values, (std::vector<std::string>{"a", "b", "c", "e", "f", "g"}));
+}
+
+TEST(BST, lower_and_upper_bound) {
+  BST<int> bst;
+  for (auto value : {10, 5, 7, 3, 13, 15})
+    bst.insert(value);
+  EXPECT_EQ(*bst.lower_bound(7), 7);
+  EXPECT_EQ(*bst.upper_bound(7), 10);
+  EXPECT_EQ(*bst.lower_bound(8), 10);
+  EXPECT_EQ(*bst.upper_bound(8), 10);
+  EXPECT_EQ(*bst.lower_bound(-1), 3);
+  EXPECT_EQ(bst.lower_bound(16), bst.end());
+  EXPECT_EQ(bst.upper_bound(15), bst.end());
+  auto const &const_bst = bst;
+  EXPECT_EQ(*const_bst.lower_bound(11), 13);
+  EXPECT_EQ(*const_bst.upper_bound(13), 15);
+}
+
+TEST(BST, equal_range_and_range) {
+  BST<int> bst;
+  for (auto value : {10, 5, 7, 3, 13, 15})
+    bst.insert(value);
+  auto [first, last] = bst.equal_range(7);
+  EXPECT_EQ(*first, 7);
+  EXPECT_EQ(*last, 10);
+  auto [missing_first, missing_last] = bst.equal_range(8);
+  EXPECT_EQ(missing_first, missing_last);
+  auto values = bst.range(5, 13);
+  EXPECT_EQ(std::vector<int>(values.begin(), values.end()), (std::vector<int>{5, 7, 10}));
+  auto const &const_bst = bst;
+  auto const_values = const_bst.range(4, 100);
+  EXPECT_EQ(std::vector<int>(const_values.begin(), const_values.end()),
+            (std::vector<int>{5, 7, 10, 13, 15}));
+  EXPECT_TRUE(bst.range(13, 5).empty());
+  EXPECT_TRUE(bst.range(8, 9).empty());
+}
+
+TEST(BST, transparent_find_by_string_view) {
+  BST<std::string, std::less<>> bst;
+  for (auto value : {"delta", "alpha", "echo", "charlie", "bravo"})
+    bst.insert(value);
+  std::string_view key{"charlie"};
+  auto itr = bst.find(key);
+  ASSERT_NE(itr, bst.end());
+  EXPECT_EQ(*itr, "charlie");
+  EXPECT_EQ(bst.find(std::string_view{"foxtrot"}), bst.end());
+  EXPECT_EQ(*bst.lower_bound(std::string_view{"c"}), "charlie");
+  EXPECT_EQ(*bst.upper_bound(std::string_view{"delta"}), "echo");
+  auto [first, last] = bst.equal_range(std::string_view{"bravo"});
+  EXPECT_EQ(*first, "bravo");
+  EXPECT_EQ(*last, "charlie");
+}
+
+struct Account {
+  int id;
+  std::string owner;
+};
+
+struct AccountIdLess {
+  using is_transparent = void;
+  bool operator()(Account const &a, Account const &b) const { return a.id < b.id; }
+  bool operator()(Account const &a, int id) const { return a.id < id; }
+  bool operator()(int id, Account const &a) const { return id < a.id; }
+};
+
+TEST(BST, transparent_find_by_key_field) {
+  BST<Account, AccountIdLess> bst;
+  bst.insert(Account{7, "seven"});
+  bst.insert(Account{3, "three"});
+  bst.insert(Account{9, "nine"});
+  auto itr = bst.find(3);
+  ASSERT_NE(itr, bst.end());
+  EXPECT_EQ((*itr).owner, "three");
+  EXPECT_EQ(bst.find(4), bst.end());
+}
+
+TEST(BST, degenerate_insert_and_find) {
+  BST<int> bst;
+  int size = 4000;
+  for (int i = 0; i < size; ++i)
+    bst.insert(i);
+  EXPECT_EQ(bst.size(), size);
+  EXPECT_FALSE(bst.insert(size / 2).second);
+  for (int i = 0; i < size; i += 7)
+    ASSERT_EQ(*bst.find(i), i);
+  EXPECT_EQ(bst.find(size), bst.end());
+}
+
+// Runs work on a thread with a stack of the given size, so deep recursion fails fast.
+void run_with_stack(std::size_t stack_size, std::function<void()> work) {
+  pthread_attr_t attributes;
+  ASSERT_EQ(pthread_attr_init(&attributes), 0);
+  ASSERT_EQ(pthread_attr_setstacksize(&attributes, stack_size), 0);
+  pthread_t thread;
+  auto run = [](void *argument) -> void * {
+    (*static_cast<std::function<void()> *>(argument))();
+    return nullptr;
+  };
+  ASSERT_EQ(pthread_create(&thread, &attributes, run, &work), 0);
+  pthread_join(thread, nullptr);
+  pthread_attr_destroy(&attributes);
+}
+
+// A chain of 200000 nodes needs megabytes of stack for any per-level recursion, far beyond the
+// 256KB given here.
+TEST(BST, degenerate_chain_on_small_stack) {
+  int size = 200000;
+  std::size_t size_after_insert = 0;
+  bool duplicate_rejected = false;
+  int deepest = -1;
+  bool missing_not_found = false;
+  TreeShape shape{};
+  run_with_stack(256 * 1024, [&]() {
+    BST<int> bst;
+    for (int i = 0; i < size; ++i)
+      bst.insert(bst.end(), i);
+    bst.insert(size);
+    size_after_insert = bst.size();
+    duplicate_rejected = !bst.insert(size - 1).second;
+    deepest = *bst.find(size);
+    missing_not_found = bst.find(size + 1) == bst.end();
+    shape = bst.shape();
+  });
+  EXPECT_EQ(size_after_insert, size + 1);
+  EXPECT_TRUE(duplicate_rejected);
+  EXPECT_EQ(deepest, size);
+  EXPECT_TRUE(missing_not_found);
+  EXPECT_EQ(shape.height, size);
+}
 
-}
\ No newline at end of file
+TEST(BST, find_batch_matches_find) {
+  BST<int> bst;
+  for (auto value : {10, 5, 7, 3, 13, 15, 1, 4, 8})
+    bst.insert(value);
+  std::vector<int> keys;
+  for (int key = 0; key < 40; ++key)
+    keys.push_back(key % 17);
+  std::vector<BST<int>::const_iterator> out(keys.size());
+  bst.find_batch(keys, out);
+  auto const &const_bst = bst;
+  for (std::size_t i = 0; i < keys.size(); ++i)
+    EXPECT_EQ(out[i], const_bst.find(keys[i]));
+}
+
+TEST(BST, height_cached_matches_recursive_height) {
+  std::default_random_engine generator(17);
+  std::uniform_int_distribution<int> distribution(0, 2000);
+  BST<int> bst;
+  HeightCachedBST<int> cached_bst;
+  for (int i = 0; i < 6000; ++i) {
+    auto number = distribution(generator);
+    if (i % 3 == 2) {
+      EXPECT_EQ(cached_bst.erase(number), bst.erase(number));
+    } else {
+      cached_bst.insert(number);
+      bst.insert(number);
+    }
+    ASSERT_EQ(cached_bst.height(), bst.height());
+  }
+  EXPECT_TRUE(std::equal(cached_bst.begin(), cached_bst.end(), bst.begin(), bst.end()));
+  HeightCachedBST<int> copy{cached_bst};
+  EXPECT_EQ(copy.height(), bst.height());
+  for (auto itr = bst.begin(); itr != bst.end(); ++itr)
+    EXPECT_EQ(cached_bst.level(*itr), bst.level(itr));
+}
+
+TEST(BST, level_and_shape) {
+  BST<int> bst;
+  EXPECT_EQ(bst.shape().size, 0);
+  EXPECT_EQ(bst.shape().height, 0);
+  for (auto value : {50, 30, 70, 20, 40, 10})
+    bst.insert(value);
+  EXPECT_EQ(bst.level(50), 0);
+  EXPECT_EQ(bst.level(40), 2);
+  EXPECT_EQ(bst.level(10), 3);
+  EXPECT_EQ(bst.level(bst.find(10)), 3);
+  EXPECT_EQ(bst.level(45), 0);
+  EXPECT_EQ(bst.find_level(45), std::nullopt);
+  EXPECT_EQ(bst.find_level(50), 0);
+  EXPECT_EQ(bst.find_level(10), 3);
+  std::size_t level = bst.level(40);
+  EXPECT_EQ(level, 2);
+  EXPECT_EQ(bst.level(bst.end()), 0);
+  auto shape = bst.shape();
+  EXPECT_EQ(shape.size, 6);
+  EXPECT_EQ(shape.height, 3);
+  EXPECT_EQ(shape.min_height, 2);
+}
+
+TEST(BST, hinted_insert) {
+  HeightCachedBST<int> cached_bst;
+  BST<int> bst;
+  auto hint = cached_bst.end();
+  for (auto value : {50, 60, 70, 55, 65, 20, 30, 10, 25, 58})
+    hint = cached_bst.insert(hint, value);
+  for (auto value : {50, 60, 70, 55, 65, 20, 30, 10, 25, 58})
+    bst.insert(value);
+  EXPECT_EQ(*cached_bst.insert(cached_bst.find(30), 30), 30);
+  EXPECT_EQ(cached_bst.insert(cached_bst.end(), 25), cached_bst.find(25));
+  auto[existing, inserted] = bst.insert(55);
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(existing, bst.find(55));
+  EXPECT_EQ(*cached_bst.emplace_hint(cached_bst.end(), 80), 80);
+  bst.insert(80);
+  EXPECT_EQ(cached_bst.size(), 11);
+  EXPECT_TRUE(std::equal(cached_bst.begin(), cached_bst.end(), bst.begin(), bst.end()));
+  EXPECT_EQ(cached_bst.height(), bst.height());
+}
+
+TEST(BST, erase_range_matches_set) {
+  std::default_random_engine generator(31);
+  std::uniform_int_distribution<int> distribution(0, 3000);
+  HeightCachedBST<int> bst;
+  std::set<int> numbers_set;
+  for (int round = 0; round < 40; ++round) {
+    for (int i = 0; i < 200; ++i) {
+      auto number = distribution(generator);
+      bst.insert(number);
+      numbers_set.insert(number);
+    }
+    auto low = distribution(generator);
+    auto high = low + distribution(generator) / 8;
+    auto itr = bst.erase(bst.lower_bound(low), bst.lower_bound(high));
+    auto expected = numbers_set.erase(numbers_set.lower_bound(low), numbers_set.lower_bound(high));
+    if (expected == numbers_set.end())
+      EXPECT_EQ(itr, bst.end());
+    else
+      EXPECT_EQ(*itr, *expected);
+    ASSERT_EQ(bst.size(), numbers_set.size());
+    ASSERT_TRUE(std::equal(bst.begin(), bst.end(), numbers_set.begin(), numbers_set.end()));
+    std::size_t max_level = 0;
+    for (auto node = bst.begin(); node != bst.end(); ++node)
+      max_level = std::max(max_level, bst.level(node));
+    ASSERT_EQ(bst.height(), max_level);
+  }
+  EXPECT_EQ(bst.erase(bst.begin(), bst.end()), bst.end());
+  EXPECT_EQ(bst.size(), 0);
+  EXPECT_EQ(bst.begin(), bst.end());
+}
+
+}
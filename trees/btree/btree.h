@@ -0,0 +1,176 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_BTREE_BTREE_H_
+#define ALGORITHMS_TREES_BTREE_BTREE_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <trees/bst.h>
+
+namespace trees {
+
+// B+-tree keeping every element in leaves linked in order. Nodes are sized to about NodeBytes so
+// a lookup touches a few cache lines per level; value_type must be default constructible.
+template<typename T, typename Comparator = std::less<T>, std::size_t NodeBytes = 256>
+class BTree {
+  struct Node;
+  struct LeafNode;
+  struct InnerNode;
+
+ public:
+  using value_type = T;
+
+  static constexpr std::size_t leaf_capacity = std::max<std::size_t>(4, NodeBytes / sizeof(T));
+  static constexpr std::size_t inner_capacity =
+      std::max<std::size_t>(4, NodeBytes / (sizeof(T) + sizeof(void *)));
+
+  explicit BTree(Comparator comp = Comparator());
+  BTree(BTree &&src) noexcept;
+  BTree(BTree const &src);
+  ~BTree();
+
+  template<bool is_const = true>
+  class base_iterator {
+    using tree_type = std::conditional_t<is_const, BTree const, BTree>;
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::conditional_t<is_const, T const, T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<is_const, T const *, T *>;
+    using reference = std::conditional_t<is_const, T const &, T &>;
+
+    inline base_iterator(base_iterator<false> const &src)
+        : base_iterator{src.tree_, src.leaf_, src.index_} {}
+    base_iterator &operator=(base_iterator const &) = default;
+
+    explicit base_iterator(BTree const *tree = nullptr, LeafNode *leaf = nullptr, std::size_t index = 0);
+    base_iterator &operator++();
+    base_iterator operator++(int);
+    base_iterator &operator--();
+    base_iterator operator--(int);
+    [[nodiscard]] bool operator==(const base_iterator &other) const;
+    [[nodiscard]] bool operator!=(const base_iterator &other) const;
+    [[nodiscard]] reference operator*() const;
+
+   private:
+    friend class base_iterator<!is_const>;
+    friend class BTree;
+
+    BTree const *tree_;
+    LeafNode *leaf_;
+    std::size_t index_;
+  };
+
+  using iterator = base_iterator<false>;
+  using const_iterator = base_iterator<true>;
+
+  [[nodiscard]] inline iterator begin() { return iterator(this, first_leaf_, 0); }
+  [[nodiscard]] inline iterator end() { return iterator(this); }
+
+  [[nodiscard]] inline const_iterator begin() const { return const_iterator(this, first_leaf_, 0); }
+  [[nodiscard]] inline const_iterator end() const { return const_iterator(this); }
+
+  std::pair<iterator, bool> insert(value_type value);
+
+  iterator erase(const_iterator position);
+  std::size_t erase(value_type const &value);
+  iterator erase(const_iterator first, const_iterator last);
+  void clear();
+
+  [[nodiscard]] inline std::size_t size() const { return size_; }
+  [[nodiscard]] inline std::size_t height() const { return height_; }
+  [[nodiscard]] const_iterator find(value_type const &value) const;
+  [[nodiscard]] iterator find(value_type const &value);
+  [[nodiscard]] const_iterator lower_bound(value_type const &value) const;
+  [[nodiscard]] iterator lower_bound(value_type const &value);
+  [[nodiscard]] const_iterator upper_bound(value_type const &value) const;
+  [[nodiscard]] iterator upper_bound(value_type const &value);
+  [[nodiscard]] IteratorRange<const_iterator> range(value_type const &first, value_type const &last) const;
+  [[nodiscard]] IteratorRange<iterator> range(value_type const &first, value_type const &last);
+
+  template<typename Key> requires detail::transparent_comparator<Comparator>
+  [[nodiscard]] inline const_iterator find(Key const &key) const {
+    auto[leaf, index] = find_position(key);
+    return const_iterator(this, leaf, index);
+  }
+  template<typename Key> requires detail::transparent_comparator<Comparator>
+  [[nodiscard]] inline iterator find(Key const &key) {
+    auto[leaf, index] = find_position(key);
+    return iterator(this, leaf, index);
+  }
+
+  [[nodiscard]] bool operator==(BTree const &other) const;
+
+ private:
+  struct Node {
+    InnerNode *parent;
+    std::size_t count;
+    bool leaf;
+  };
+
+  // Both node kinds keep one spare slot so an insertion can overflow before the node is split.
+  struct LeafNode : Node {
+    std::array<T, leaf_capacity + 1> keys;
+    LeafNode *prev;
+    LeafNode *next;
+  };
+
+  struct InnerNode : Node {
+    std::array<T, inner_capacity + 1> keys;
+    std::array<Node *, inner_capacity + 2> children;
+  };
+
+  Comparator comp_;
+  Node *root_;
+  LeafNode *first_leaf_;
+  LeafNode *last_leaf_;
+  std::size_t size_;
+  std::size_t height_;
+
+  template<typename Key>
+  [[nodiscard]] LeafNode *find_leaf(Key const &key) const;
+  template<typename Key>
+  [[nodiscard]] std::pair<LeafNode *, std::size_t> find_position(Key const &key) const;
+  template<typename Key>
+  [[nodiscard]] std::pair<LeafNode *, std::size_t> lower_bound_position(Key const &key) const;
+  template<typename Key>
+  [[nodiscard]] std::pair<LeafNode *, std::size_t> upper_bound_position(Key const &key) const;
+
+  static std::size_t child_index(InnerNode const *parent, Node const *child);
+  LeafNode *split_leaf(LeafNode *leaf);
+  void split_inner(InnerNode *node);
+  void insert_into_parent(Node *left, T const &key, Node *right);
+  void rebalance_leaf(LeafNode *leaf);
+  void rebalance_inner(InnerNode *node);
+  void remove_child(InnerNode *parent, std::size_t key_index);
+
+  Node *clone(Node const *node, InnerNode *parent, LeafNode *&last_leaf);
+  static void destroy(Node *node);
+};
+
+}
+#endif //ALGORITHMS_TREES_BTREE_BTREE_H_
@@ -0,0 +1,537 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_BTREE_BTREE_IPP_
+#define ALGORITHMS_TREES_BTREE_BTREE_IPP_
+
+#include <trees/btree/btree.h>
+#include <trees/bst.ipp>
+
+namespace trees {
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+template<bool is_const>
+BTree<T, Comparator, NodeBytes>::base_iterator<is_const>::base_iterator(BTree const *tree,
+                                                                        LeafNode *leaf,
+                                                                        std::size_t index)
+    : tree_{tree}, leaf_{leaf}, index_{index} {}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+template<bool is_const>
+typename BTree<T, Comparator, NodeBytes>::template base_iterator<is_const> &
+BTree<T, Comparator, NodeBytes>::base_iterator<is_const>::operator++() {
+  if (leaf_ && ++index_ == leaf_->count) {
+    leaf_ = leaf_->next;
+    index_ = 0;
+  }
+  return *this;
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+template<bool is_const>
+typename BTree<T, Comparator, NodeBytes>::template base_iterator<is_const>
+BTree<T, Comparator, NodeBytes>::base_iterator<is_const>::operator++(int) {
+  base_iterator<is_const> retval = *this;
+  ++(*this);
+  return retval;
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+template<bool is_const>
+typename BTree<T, Comparator, NodeBytes>::template base_iterator<is_const> &
+BTree<T, Comparator, NodeBytes>::base_iterator<is_const>::operator--() {
+  if (!leaf_) {
+    leaf_ = tree_ ? tree_->last_leaf_ : nullptr;
+    index_ = leaf_ ? leaf_->count - 1 : 0;
+  } else if (index_ == 0) {
+    leaf_ = leaf_->prev;
+    index_ = leaf_ ? leaf_->count - 1 : 0;
+  } else {
+    --index_;
+  }
+  return *this;
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+template<bool is_const>
+typename BTree<T, Comparator, NodeBytes>::template base_iterator<is_const>
+BTree<T, Comparator, NodeBytes>::base_iterator<is_const>::operator--(int) {
+  base_iterator<is_const> retval = *this;
+  --(*this);
+  return retval;
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+template<bool is_const>
+bool BTree<T, Comparator, NodeBytes>::base_iterator<is_const>::operator==(const base_iterator &other) const {
+  return leaf_ == other.leaf_ && index_ == other.index_;
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+template<bool is_const>
+bool BTree<T, Comparator, NodeBytes>::base_iterator<is_const>::operator!=(const base_iterator &other) const {
+  return !(*this == other);
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+template<bool is_const>
+typename BTree<T, Comparator, NodeBytes>::template base_iterator<is_const>::reference
+BTree<T, Comparator, NodeBytes>::base_iterator<is_const>::operator*() const {
+  return leaf_->keys[index_];
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+BTree<T, Comparator, NodeBytes>::BTree(Comparator comp)
+    : comp_{comp}, root_{nullptr}, first_leaf_{nullptr}, last_leaf_{nullptr}, size_{0}, height_{0} {}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+BTree<T, Comparator, NodeBytes>::BTree(BTree &&src) noexcept
+    : comp_{src.comp_},
+      root_{src.root_},
+      first_leaf_{src.first_leaf_},
+      last_leaf_{src.last_leaf_},
+      size_{src.size_},
+      height_{src.height_} {
+  src.root_ = nullptr;
+  src.first_leaf_ = src.last_leaf_ = nullptr;
+  src.size_ = src.height_ = 0;
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+BTree<T, Comparator, NodeBytes>::BTree(BTree const &src)
+    : comp_{src.comp_}, root_{nullptr}, first_leaf_{nullptr}, last_leaf_{nullptr},
+      size_{src.size_}, height_{src.height_} {
+  if (src.root_)
+    root_ = clone(src.root_, nullptr, last_leaf_);
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+BTree<T, Comparator, NodeBytes>::~BTree() {
+  destroy(root_);
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+void BTree<T, Comparator, NodeBytes>::clear() {
+  destroy(root_);
+  root_ = nullptr;
+  first_leaf_ = last_leaf_ = nullptr;
+  size_ = height_ = 0;
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+typename BTree<T, Comparator, NodeBytes>::Node *
+BTree<T, Comparator, NodeBytes>::clone(Node const *node, InnerNode *parent, LeafNode *&last_leaf) {
+  if (node->leaf) {
+    auto src = static_cast<LeafNode const *>(node);
+    auto res = new LeafNode{{parent, src->count, true}, src->keys, last_leaf, nullptr};
+    if (last_leaf)
+      last_leaf->next = res;
+    else
+      first_leaf_ = res;
+    last_leaf = res;
+    return res;
+  }
+  auto src = static_cast<InnerNode const *>(node);
+  auto res = new InnerNode{{parent, src->count, false}, src->keys, {}};
+  for (std::size_t i = 0; i <= src->count; ++i)
+    res->children[i] = clone(src->children[i], res, last_leaf);
+  return res;
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+void BTree<T, Comparator, NodeBytes>::destroy(Node *node) {
+  if (!node)
+    return;
+  if (node->leaf) {
+    delete static_cast<LeafNode *>(node);
+  } else {
+    auto inner = static_cast<InnerNode *>(node);
+    for (std::size_t i = 0; i <= inner->count; ++i)
+      destroy(inner->children[i]);
+    delete inner;
+  }
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+template<typename Key>
+typename BTree<T, Comparator, NodeBytes>::LeafNode *
+BTree<T, Comparator, NodeBytes>::find_leaf(Key const &key) const {
+  auto node = root_;
+  while (node && !node->leaf) {
+    auto inner = static_cast<InnerNode *>(node);
+    auto separator = std::upper_bound(inner->keys.begin(), inner->keys.begin() + inner->count, key, comp_);
+    node = inner->children[separator - inner->keys.begin()];
+  }
+  return static_cast<LeafNode *>(node);
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+template<typename Key>
+std::pair<typename BTree<T, Comparator, NodeBytes>::LeafNode *, std::size_t>
+BTree<T, Comparator, NodeBytes>::lower_bound_position(Key const &key) const {
+  auto leaf = find_leaf(key);
+  if (!leaf)
+    return std::make_pair(nullptr, 0);
+  auto position = std::lower_bound(leaf->keys.begin(), leaf->keys.begin() + leaf->count, key, comp_);
+  std::size_t index = position - leaf->keys.begin();
+  if (index == leaf->count)
+    return std::make_pair(leaf->next, 0);
+  return std::make_pair(leaf, index);
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+template<typename Key>
+std::pair<typename BTree<T, Comparator, NodeBytes>::LeafNode *, std::size_t>
+BTree<T, Comparator, NodeBytes>::upper_bound_position(Key const &key) const {
+  auto leaf = find_leaf(key);
+  if (!leaf)
+    return std::make_pair(nullptr, 0);
+  auto position = std::upper_bound(leaf->keys.begin(), leaf->keys.begin() + leaf->count, key, comp_);
+  std::size_t index = position - leaf->keys.begin();
+  if (index == leaf->count)
+    return std::make_pair(leaf->next, 0);
+  return std::make_pair(leaf, index);
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+template<typename Key>
+std::pair<typename BTree<T, Comparator, NodeBytes>::LeafNode *, std::size_t>
+BTree<T, Comparator, NodeBytes>::find_position(Key const &key) const {
+  auto[leaf, index] = lower_bound_position(key);
+  if (!leaf || comp_(key, leaf->keys[index]))
+    return std::make_pair(nullptr, 0);
+  return std::make_pair(leaf, index);
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+typename BTree<T, Comparator, NodeBytes>::const_iterator
+BTree<T, Comparator, NodeBytes>::find(value_type const &value) const {
+  auto[leaf, index] = find_position(value);
+  return const_iterator(this, leaf, index);
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+typename BTree<T, Comparator, NodeBytes>::iterator
+BTree<T, Comparator, NodeBytes>::find(value_type const &value) {
+  auto[leaf, index] = find_position(value);
+  return iterator(this, leaf, index);
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+typename BTree<T, Comparator, NodeBytes>::const_iterator
+BTree<T, Comparator, NodeBytes>::lower_bound(value_type const &value) const {
+  auto[leaf, index] = lower_bound_position(value);
+  return const_iterator(this, leaf, index);
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+typename BTree<T, Comparator, NodeBytes>::iterator
+BTree<T, Comparator, NodeBytes>::lower_bound(value_type const &value) {
+  auto[leaf, index] = lower_bound_position(value);
+  return iterator(this, leaf, index);
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+typename BTree<T, Comparator, NodeBytes>::const_iterator
+BTree<T, Comparator, NodeBytes>::upper_bound(value_type const &value) const {
+  auto[leaf, index] = upper_bound_position(value);
+  return const_iterator(this, leaf, index);
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+typename BTree<T, Comparator, NodeBytes>::iterator
+BTree<T, Comparator, NodeBytes>::upper_bound(value_type const &value) {
+  auto[leaf, index] = upper_bound_position(value);
+  return iterator(this, leaf, index);
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+IteratorRange<typename BTree<T, Comparator, NodeBytes>::const_iterator>
+BTree<T, Comparator, NodeBytes>::range(value_type const &first, value_type const &last) const {
+  auto first_itr = lower_bound(first);
+  if (!comp_(first, last))
+    return IteratorRange<const_iterator>(first_itr, first_itr);
+  return IteratorRange<const_iterator>(first_itr, lower_bound(last));
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+IteratorRange<typename BTree<T, Comparator, NodeBytes>::iterator>
+BTree<T, Comparator, NodeBytes>::range(value_type const &first, value_type const &last) {
+  auto first_itr = lower_bound(first);
+  if (!comp_(first, last))
+    return IteratorRange<iterator>(first_itr, first_itr);
+  return IteratorRange<iterator>(first_itr, lower_bound(last));
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+std::pair<typename BTree<T, Comparator, NodeBytes>::iterator, bool>
+BTree<T, Comparator, NodeBytes>::insert(value_type value) {
+  if (!root_) {
+    auto leaf = new LeafNode{{nullptr, 1, true}, {}, nullptr, nullptr};
+    leaf->keys[0] = std::move(value);
+    root_ = first_leaf_ = last_leaf_ = leaf;
+    size_ = 1;
+    return std::make_pair(iterator(this, leaf, 0), true);
+  }
+  auto leaf = find_leaf(value);
+  auto position = std::lower_bound(leaf->keys.begin(), leaf->keys.begin() + leaf->count, value, comp_);
+  std::size_t index = position - leaf->keys.begin();
+  if (index < leaf->count && !comp_(value, leaf->keys[index]))
+    return std::make_pair(iterator(this, leaf, index), false);
+  std::move_backward(leaf->keys.begin() + index,
+                     leaf->keys.begin() + leaf->count,
+                     leaf->keys.begin() + leaf->count + 1);
+  leaf->keys[index] = std::move(value);
+  ++leaf->count;
+  ++size_;
+  if (leaf->count > leaf_capacity) {
+    auto right = split_leaf(leaf);
+    if (index >= leaf->count)
+      return std::make_pair(iterator(this, right, index - leaf->count), true);
+  }
+  return std::make_pair(iterator(this, leaf, index), true);
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+std::size_t BTree<T, Comparator, NodeBytes>::child_index(InnerNode const *parent, Node const *child) {
+  std::size_t index = 0;
+  while (parent->children[index] != child)
+    ++index;
+  return index;
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+typename BTree<T, Comparator, NodeBytes>::LeafNode *
+BTree<T, Comparator, NodeBytes>::split_leaf(LeafNode *leaf) {
+  auto middle = leaf->count / 2;
+  auto right = new LeafNode{{leaf->parent, leaf->count - middle, true}, {}, leaf, leaf->next};
+  std::move(leaf->keys.begin() + middle, leaf->keys.begin() + leaf->count, right->keys.begin());
+  leaf->count = middle;
+  if (leaf->next)
+    leaf->next->prev = right;
+  else
+    last_leaf_ = right;
+  leaf->next = right;
+  insert_into_parent(leaf, right->keys[0], right);
+  return right;
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+void BTree<T, Comparator, NodeBytes>::split_inner(InnerNode *node) {
+  auto middle = node->count / 2;
+  auto right = new InnerNode{{node->parent, node->count - middle - 1, false}, {}, {}};
+  std::move(node->keys.begin() + middle + 1, node->keys.begin() + node->count, right->keys.begin());
+  for (std::size_t i = 0; i <= right->count; ++i) {
+    right->children[i] = node->children[middle + 1 + i];
+    right->children[i]->parent = right;
+  }
+  node->count = middle;
+  insert_into_parent(node, node->keys[middle], right);
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+void BTree<T, Comparator, NodeBytes>::insert_into_parent(Node *left, T const &key, Node *right) {
+  auto parent = left->parent;
+  if (!parent) {
+    auto root = new InnerNode{{nullptr, 1, false}, {}, {}};
+    root->keys[0] = key;
+    root->children[0] = left;
+    root->children[1] = right;
+    left->parent = right->parent = root;
+    root_ = root;
+    ++height_;
+    return;
+  }
+  auto index = child_index(parent, left);
+  std::move_backward(parent->keys.begin() + index,
+                     parent->keys.begin() + parent->count,
+                     parent->keys.begin() + parent->count + 1);
+  std::move_backward(parent->children.begin() + index + 1,
+                     parent->children.begin() + parent->count + 1,
+                     parent->children.begin() + parent->count + 2);
+  parent->keys[index] = key;
+  parent->children[index + 1] = right;
+  right->parent = parent;
+  ++parent->count;
+  if (parent->count > inner_capacity)
+    split_inner(parent);
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+typename BTree<T, Comparator, NodeBytes>::iterator
+BTree<T, Comparator, NodeBytes>::erase(const_iterator position) {
+  auto leaf = position.leaf_;
+  if (!leaf)
+    return end();
+  auto index = position.index_;
+  T erased = std::move(leaf->keys[index]);
+  std::move(leaf->keys.begin() + index + 1, leaf->keys.begin() + leaf->count, leaf->keys.begin() + index);
+  --leaf->count;
+  --size_;
+  if (leaf == root_) {
+    if (leaf->count == 0)
+      clear();
+  } else if (leaf->count < leaf_capacity / 2) {
+    rebalance_leaf(leaf);
+  }
+  return lower_bound(erased);
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+std::size_t BTree<T, Comparator, NodeBytes>::erase(value_type const &value) {
+  auto itr = find(value);
+  if (itr != end()) {
+    erase(itr);
+    return 1;
+  }
+  return 0;
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+typename BTree<T, Comparator, NodeBytes>::iterator
+BTree<T, Comparator, NodeBytes>::erase(const_iterator first, const_iterator last) {
+  iterator res{this, first.leaf_, first.index_};
+  if (last == end()) {
+    while (res != end())
+      res = erase(res);
+  } else {
+    T last_value = *last;
+    while (res != end() && comp_(*res, last_value))
+      res = erase(res);
+  }
+  return res;
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+void BTree<T, Comparator, NodeBytes>::remove_child(InnerNode *parent, std::size_t key_index) {
+  std::move(parent->keys.begin() + key_index + 1,
+            parent->keys.begin() + parent->count,
+            parent->keys.begin() + key_index);
+  std::move(parent->children.begin() + key_index + 2,
+            parent->children.begin() + parent->count + 1,
+            parent->children.begin() + key_index + 1);
+  --parent->count;
+  rebalance_inner(parent);
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+void BTree<T, Comparator, NodeBytes>::rebalance_leaf(LeafNode *leaf) {
+  auto parent = leaf->parent;
+  auto index = child_index(parent, leaf);
+  auto left = index > 0 ? static_cast<LeafNode *>(parent->children[index - 1]) : nullptr;
+  auto right = index < parent->count ? static_cast<LeafNode *>(parent->children[index + 1]) : nullptr;
+  if (left && left->count > leaf_capacity / 2) {
+    std::move_backward(leaf->keys.begin(), leaf->keys.begin() + leaf->count, leaf->keys.begin() + leaf->count + 1);
+    leaf->keys[0] = std::move(left->keys[left->count - 1]);
+    --left->count;
+    ++leaf->count;
+    parent->keys[index - 1] = leaf->keys[0];
+  } else if (right && right->count > leaf_capacity / 2) {
+    leaf->keys[leaf->count] = std::move(right->keys[0]);
+    std::move(right->keys.begin() + 1, right->keys.begin() + right->count, right->keys.begin());
+    --right->count;
+    ++leaf->count;
+    parent->keys[index] = right->keys[0];
+  } else {
+    if (left) {
+      right = leaf;
+      --index;
+    } else {
+      left = leaf;
+    }
+    std::move(right->keys.begin(), right->keys.begin() + right->count, left->keys.begin() + left->count);
+    left->count += right->count;
+    left->next = right->next;
+    if (right->next)
+      right->next->prev = left;
+    else
+      last_leaf_ = left;
+    delete right;
+    remove_child(parent, index);
+  }
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+void BTree<T, Comparator, NodeBytes>::rebalance_inner(InnerNode *node) {
+  if (node == root_) {
+    if (node->count == 0) {
+      root_ = node->children[0];
+      root_->parent = nullptr;
+      delete node;
+      --height_;
+    }
+    return;
+  }
+  if (node->count >= inner_capacity / 2)
+    return;
+  auto parent = node->parent;
+  auto index = child_index(parent, node);
+  auto left = index > 0 ? static_cast<InnerNode *>(parent->children[index - 1]) : nullptr;
+  auto right = index < parent->count ? static_cast<InnerNode *>(parent->children[index + 1]) : nullptr;
+  if (left && left->count > inner_capacity / 2) {
+    std::move_backward(node->keys.begin(), node->keys.begin() + node->count, node->keys.begin() + node->count + 1);
+    std::move_backward(node->children.begin(),
+                       node->children.begin() + node->count + 1,
+                       node->children.begin() + node->count + 2);
+    node->keys[0] = std::move(parent->keys[index - 1]);
+    node->children[0] = left->children[left->count];
+    node->children[0]->parent = node;
+    parent->keys[index - 1] = std::move(left->keys[left->count - 1]);
+    --left->count;
+    ++node->count;
+  } else if (right && right->count > inner_capacity / 2) {
+    node->keys[node->count] = std::move(parent->keys[index]);
+    node->children[node->count + 1] = right->children[0];
+    node->children[node->count + 1]->parent = node;
+    parent->keys[index] = std::move(right->keys[0]);
+    std::move(right->keys.begin() + 1, right->keys.begin() + right->count, right->keys.begin());
+    std::move(right->children.begin() + 1, right->children.begin() + right->count + 1, right->children.begin());
+    --right->count;
+    ++node->count;
+  } else {
+    if (left) {
+      right = node;
+      --index;
+    } else {
+      left = node;
+    }
+    left->keys[left->count] = std::move(parent->keys[index]);
+    std::move(right->keys.begin(), right->keys.begin() + right->count, left->keys.begin() + left->count + 1);
+    for (std::size_t i = 0; i <= right->count; ++i) {
+      left->children[left->count + 1 + i] = right->children[i];
+      right->children[i]->parent = left;
+    }
+    left->count += right->count + 1;
+    delete right;
+    remove_child(parent, index);
+  }
+}
+
+template<typename T, typename Comparator, std::size_t NodeBytes>
+bool BTree<T, Comparator, NodeBytes>::operator==(BTree const &other) const {
+  return size() == other.size() && std::equal(begin(), end(), other.begin());
+}
+
+}
+#endif
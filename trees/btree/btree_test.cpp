@@ -0,0 +1,162 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <trees/btree/btree.h>
+#include <trees/btree/btree.ipp>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace trees::test {
+
+// Four keys per node, so even small trees grow several levels and exercise every split and merge.
+using SmallBTree = BTree<int, std::less<int>, 16>;
+
+TEST(BTree, insert_and_iterate) {
+  SmallBTree tree;
+  EXPECT_EQ(tree.begin(), tree.end());
+  for (auto value : {50, 20, 80, 10, 30, 70, 90, 60, 40, 15, 25, 35})
+    EXPECT_TRUE(tree.insert(value).second);
+  EXPECT_FALSE(tree.insert(30).second);
+  EXPECT_EQ(*tree.insert(30).first, 30);
+  EXPECT_EQ(tree.size(), 12);
+  EXPECT_GE(tree.height(), 1);
+  std::vector<int> expected{10, 15, 20, 25, 30, 35, 40, 50, 60, 70, 80, 90};
+  EXPECT_TRUE(std::equal(tree.begin(), tree.end(), expected.begin(), expected.end()));
+
+  std::vector<int> reversed;
+  for (auto itr = tree.end(); itr != tree.begin();)
+    reversed.push_back(*--itr);
+  EXPECT_TRUE(std::equal(reversed.begin(), reversed.end(), expected.rbegin(), expected.rend()));
+}
+
+TEST(BTree, find_and_bounds) {
+  SmallBTree tree;
+  for (int i = 0; i < 100; i += 10)
+    tree.insert(i);
+  EXPECT_EQ(*tree.find(40), 40);
+  EXPECT_EQ(tree.find(45), tree.end());
+  EXPECT_EQ(*tree.lower_bound(45), 50);
+  EXPECT_EQ(*tree.lower_bound(50), 50);
+  EXPECT_EQ(*tree.upper_bound(50), 60);
+  EXPECT_EQ(tree.lower_bound(95), tree.end());
+  EXPECT_EQ(*tree.lower_bound(-5), 0);
+
+  std::vector<int> expected{30, 40, 50, 60};
+  auto range = tree.range(25, 65);
+  EXPECT_TRUE(std::equal(range.begin(), range.end(), expected.begin(), expected.end()));
+  EXPECT_TRUE(tree.range(65, 25).empty());
+  EXPECT_TRUE(tree.range(41, 49).empty());
+}
+
+TEST(BTree, random_insert_and_erase_matches_set) {
+  std::default_random_engine generator(7);
+  std::uniform_int_distribution<int> distribution(0, 3000);
+  SmallBTree tree;
+  std::set<int> numbers_set;
+  for (int i = 0; i < 30000; ++i) {
+    auto number = distribution(generator);
+    if (i % 3 == 2) {
+      EXPECT_EQ(tree.erase(number), numbers_set.erase(number));
+    } else {
+      EXPECT_EQ(tree.insert(number).second, numbers_set.insert(number).second);
+    }
+    ASSERT_EQ(tree.size(), numbers_set.size());
+  }
+  EXPECT_TRUE(std::equal(tree.begin(), tree.end(), numbers_set.begin(), numbers_set.end()));
+  for (auto number : std::vector<int>(numbers_set.begin(), numbers_set.end())) {
+    auto next = numbers_set.upper_bound(number);
+    auto itr = tree.erase(tree.find(number));
+    if (next == numbers_set.end())
+      EXPECT_EQ(itr, tree.end());
+    else
+      EXPECT_EQ(*itr, *next);
+    numbers_set.erase(number);
+  }
+  EXPECT_EQ(tree.size(), 0);
+  EXPECT_EQ(tree.height(), 0);
+  EXPECT_EQ(tree.begin(), tree.end());
+}
+
+TEST(BTree, erase_range) {
+  SmallBTree tree;
+  for (int i = 0; i < 200; ++i)
+    tree.insert(i);
+  auto itr = tree.erase(tree.find(50), tree.find(150));
+  EXPECT_EQ(*itr, 150);
+  EXPECT_EQ(tree.size(), 100);
+  EXPECT_EQ(tree.find(100), tree.end());
+  EXPECT_EQ(*std::prev(tree.find(150)), 49);
+  EXPECT_EQ(tree.erase(tree.find(150), tree.end()), tree.end());
+  EXPECT_EQ(tree.size(), 50);
+  EXPECT_EQ(*std::prev(tree.end()), 49);
+}
+
+TEST(BTree, copy_move_and_compare) {
+  SmallBTree tree;
+  for (int i = 0; i < 500; i += 3)
+    tree.insert(i);
+  SmallBTree copy{tree};
+  EXPECT_EQ(copy, tree);
+  EXPECT_EQ(copy.height(), tree.height());
+  copy.erase(3);
+  EXPECT_FALSE(copy == tree);
+  EXPECT_TRUE(std::equal(std::next(copy.begin()), copy.end(), std::next(tree.begin(), 2), tree.end()));
+
+  SmallBTree moved{std::move(tree)};
+  EXPECT_EQ(tree.size(), 0);
+  EXPECT_EQ(tree.begin(), tree.end());
+  EXPECT_EQ(moved.size(), 167);
+  EXPECT_EQ(*std::prev(moved.end()), 498);
+}
+
+TEST(BTree, default_node_size_is_shallow) {
+  BTree<int> tree;
+  for (int i = 0; i < 100000; ++i)
+    tree.insert(i);
+  EXPECT_EQ(BTree<int>::leaf_capacity, 64);
+  EXPECT_LE(tree.height(), 4);
+  int expected = 0;
+  for (auto value : tree)
+    EXPECT_EQ(value, expected++);
+}
+
+TEST(BTree, string_keys_with_transparent_find) {
+  BTree<std::string, std::less<>, 128> tree;
+  std::vector<std::string> words{"pear", "apple", "fig", "kiwi", "plum", "lime", "date", "grape", "melon"};
+  for (auto const &word : words)
+    tree.insert(word);
+  std::sort(words.begin(), words.end());
+  EXPECT_TRUE(std::equal(tree.begin(), tree.end(), words.begin(), words.end()));
+  EXPECT_EQ(*tree.find(std::string_view{"kiwi"}), "kiwi");
+  EXPECT_EQ(tree.find(std::string_view{"banana"}), tree.end());
+  tree.erase("fig");
+  EXPECT_EQ(tree.find("fig"), tree.end());
+  EXPECT_EQ(tree.size(), 8);
+}
+
+}
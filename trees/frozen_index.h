@@ -0,0 +1,88 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_FROZEN_INDEX_H_
+#define ALGORITHMS_TREES_FROZEN_INDEX_H_
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+#include <trees/bst.h>
+
+namespace trees {
+
+// Immutable sorted set stored in Eytzinger (BFS) order: the children of slot k live at 2k and
+// 2k + 1, so a search is a branch-free walk down an implicit tree and the nodes a few levels
+// below k share a cache line that can be prefetched ahead of time.
+template<typename T, typename Comparator = std::less<T>>
+class FrozenIndex {
+ public:
+  using value_type = T;
+  using const_pointer = T const *;
+
+  explicit FrozenIndex(Comparator comp = Comparator());
+
+  // first..last must be sorted by comp and hold no duplicates.
+  template<typename ForwardIt>
+  FrozenIndex(ForwardIt first, ForwardIt last, Comparator comp = Comparator());
+
+  // Snapshots any ordered container, such as a BST or AVLTree.
+  template<typename Range> requires requires(Range const &range) { range.begin(); range.end(); }
+  explicit FrozenIndex(Range const &range, Comparator comp = Comparator());
+
+  [[nodiscard]] inline std::size_t size() const { return keys_.size() - 1; }
+  [[nodiscard]] inline bool empty() const { return size() == 0; }
+
+  // Both return nullptr when there is no such element.
+  [[nodiscard]] const_pointer find(value_type const &value) const;
+  [[nodiscard]] const_pointer lower_bound(value_type const &value) const;
+  [[nodiscard]] bool contains(value_type const &value) const;
+
+  template<typename Key> requires detail::transparent_comparator<Comparator>
+  [[nodiscard]] inline const_pointer find(Key const &key) const { return find_slot(key); }
+  template<typename Key> requires detail::transparent_comparator<Comparator>
+  [[nodiscard]] inline const_pointer lower_bound(Key const &key) const { return lower_bound_slot(key); }
+  template<typename Key> requires detail::transparent_comparator<Comparator>
+  [[nodiscard]] inline bool contains(Key const &key) const { return find_slot(key) != nullptr; }
+
+ private:
+  // Slots 0..prefetch_stride-1 of the subtree below k, i.e. four levels down for 4-byte keys, start
+  // at k * prefetch_stride.
+  static constexpr std::size_t prefetch_stride = sizeof(T) < 64 ? 64 / sizeof(T) : 1;
+
+  Comparator comp_;
+  // Slot 0 is padding so the root is at 1 and the child arithmetic needs no offsets.
+  std::vector<T> keys_;
+
+  template<typename ForwardIt>
+  void build(ForwardIt &itr, std::size_t slot);
+
+  template<typename Key>
+  [[nodiscard]] const_pointer lower_bound_slot(Key const &key) const;
+  template<typename Key>
+  [[nodiscard]] const_pointer find_slot(Key const &key) const;
+};
+
+}
+#endif //ALGORITHMS_TREES_FROZEN_INDEX_H_
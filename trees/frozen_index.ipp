@@ -0,0 +1,101 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_FROZEN_INDEX_IPP_
+#define ALGORITHMS_TREES_FROZEN_INDEX_IPP_
+
+#include <bit>
+#include <trees/frozen_index.h>
+
+namespace trees {
+
+template<typename T, typename Comparator>
+FrozenIndex<T, Comparator>::FrozenIndex(Comparator comp) : comp_{comp}, keys_(1) {}
+
+template<typename T, typename Comparator>
+template<typename ForwardIt>
+FrozenIndex<T, Comparator>::FrozenIndex(ForwardIt first, ForwardIt last, Comparator comp)
+    : comp_{comp}, keys_(1 + std::distance(first, last)) {
+  build(first, 1);
+}
+
+template<typename T, typename Comparator>
+template<typename Range> requires requires(Range const &range) { range.begin(); range.end(); }
+FrozenIndex<T, Comparator>::FrozenIndex(Range const &range, Comparator comp)
+    : FrozenIndex(range.begin(), range.end(), comp) {}
+
+template<typename T, typename Comparator>
+template<typename ForwardIt>
+void FrozenIndex<T, Comparator>::build(ForwardIt &itr, std::size_t slot) {
+  if (slot >= keys_.size())
+    return;
+  build(itr, 2 * slot);
+  keys_[slot] = *itr++;
+  build(itr, 2 * slot + 1);
+}
+
+template<typename T, typename Comparator>
+template<typename Key>
+typename FrozenIndex<T, Comparator>::const_pointer
+FrozenIndex<T, Comparator>::lower_bound_slot(Key const &key) const {
+  auto keys = keys_.data();
+  std::size_t size = keys_.size();
+  std::size_t slot = 1;
+  while (slot < size) {
+    detail::prefetch(keys + slot * prefetch_stride);
+    slot = 2 * slot + comp_(keys[slot], key);
+  }
+  // The path went right (bit 1) after every element smaller than key; dropping those trailing
+  // right turns and the last left turn lands on the smallest element not less than key.
+  slot >>= std::countr_one(slot) + 1;
+  return slot ? keys + slot : nullptr;
+}
+
+template<typename T, typename Comparator>
+template<typename Key>
+typename FrozenIndex<T, Comparator>::const_pointer
+FrozenIndex<T, Comparator>::find_slot(Key const &key) const {
+  auto slot = lower_bound_slot(key);
+  return slot && !comp_(key, *slot) ? slot : nullptr;
+}
+
+template<typename T, typename Comparator>
+typename FrozenIndex<T, Comparator>::const_pointer
+FrozenIndex<T, Comparator>::find(value_type const &value) const {
+  return find_slot(value);
+}
+
+template<typename T, typename Comparator>
+typename FrozenIndex<T, Comparator>::const_pointer
+FrozenIndex<T, Comparator>::lower_bound(value_type const &value) const {
+  return lower_bound_slot(value);
+}
+
+template<typename T, typename Comparator>
+bool FrozenIndex<T, Comparator>::contains(value_type const &value) const {
+  return find_slot(value) != nullptr;
+}
+
+}
+#endif
@@ -0,0 +1,138 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <trees/frozen_index.h>
+#include <trees/frozen_index.ipp>
+#include <trees/avl/avl_tree.h>
+#include <trees/avl/avl_tree.ipp>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace trees::test {
+
+TEST(FrozenIndex, empty) {
+  FrozenIndex<int> index;
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(index.find(1), nullptr);
+  EXPECT_EQ(index.lower_bound(1), nullptr);
+  EXPECT_FALSE(index.contains(1));
+}
+
+TEST(FrozenIndex, every_size_up_to_64) {
+  for (int size = 1; size <= 64; ++size) {
+    std::vector<int> numbers(size);
+    for (int i = 0; i < size; ++i)
+      numbers[i] = 10 * i;
+    FrozenIndex<int> index{numbers.begin(), numbers.end()};
+    EXPECT_EQ(index.size(), size);
+    for (int key = -5; key <= 10 * size; key += 5) {
+      auto expected = std::lower_bound(numbers.begin(), numbers.end(), key);
+      auto found = index.lower_bound(key);
+      if (expected == numbers.end()) {
+        EXPECT_EQ(found, nullptr) << "size " << size << " key " << key;
+      } else {
+        ASSERT_NE(found, nullptr) << "size " << size << " key " << key;
+        EXPECT_EQ(*found, *expected);
+      }
+      EXPECT_EQ(index.contains(key), key >= 0 && key % 10 == 0 && key < 10 * size);
+    }
+  }
+}
+
+TEST(FrozenIndex, snapshot_of_trees) {
+  std::default_random_engine generator(3);
+  std::uniform_int_distribution<int> distribution(0, 100000);
+  avl::AVLTree<int> avl_tree;
+  BST<int> bst;
+  std::set<int> numbers_set;
+  for (int i = 0; i < 5000; ++i) {
+    auto number = distribution(generator);
+    avl_tree.insert(number);
+    bst.insert(number);
+    numbers_set.insert(number);
+  }
+  FrozenIndex<int> from_avl{avl_tree};
+  FrozenIndex<int> from_bst{bst};
+  EXPECT_EQ(from_avl.size(), numbers_set.size());
+  for (int i = 0; i < 5000; ++i) {
+    auto key = distribution(generator);
+    auto expected = numbers_set.lower_bound(key);
+    auto found = from_avl.lower_bound(key);
+    EXPECT_EQ(found == nullptr, expected == numbers_set.end());
+    if (found) {
+      EXPECT_EQ(*found, *expected);
+    }
+    EXPECT_EQ(from_avl.contains(key), numbers_set.count(key) == 1);
+    EXPECT_EQ(from_bst.contains(key), numbers_set.count(key) == 1);
+  }
+}
+
+TEST(FrozenIndex, string_keys_with_transparent_find) {
+  std::vector<std::string> words{"apple", "date", "fig", "grape", "kiwi", "lime", "melon", "pear", "plum"};
+  FrozenIndex<std::string, std::less<>> index{words};
+  EXPECT_EQ(*index.find(std::string_view{"kiwi"}), "kiwi");
+  EXPECT_EQ(index.find(std::string_view{"banana"}), nullptr);
+  EXPECT_EQ(*index.lower_bound(std::string_view{"banana"}), "date");
+  EXPECT_TRUE(index.contains("plum"));
+  EXPECT_EQ(index.lower_bound("zucchini"), nullptr);
+}
+
+TEST(FrozenIndex, benchmark_find_vs_avl_find) {
+  std::size_t size = 1 << 21;
+  std::vector<unsigned int> numbers(size);
+  for (std::size_t i = 0; i < size; ++i)
+    numbers[i] = 2 * i;
+  avl::AVLTree<unsigned int> avl_tree{numbers.begin(), numbers.end()};
+  FrozenIndex<unsigned int> index{avl_tree};
+  std::default_random_engine generator(42);
+  std::uniform_int_distribution<unsigned int> distribution(0, 2 * size);
+  std::vector<unsigned int> keys(1 << 18);
+  for (auto &key : keys)
+    key = distribution(generator);
+
+  std::size_t avl_hits = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (auto key : keys)
+    avl_hits += avl_tree.find(key) != avl_tree.end();
+  auto finish = std::chrono::high_resolution_clock::now();
+  auto avl_us = std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+
+  std::size_t frozen_hits = 0;
+  start = std::chrono::high_resolution_clock::now();
+  for (auto key : keys)
+    frozen_hits += index.contains(key);
+  finish = std::chrono::high_resolution_clock::now();
+  auto frozen_us = std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+
+  EXPECT_EQ(avl_hits, frozen_hits);
+  std::cout << "AVLTree::find: " << avl_us << "us FrozenIndex::contains: " << frozen_us << "us" << std::endl;
+}
+
+}
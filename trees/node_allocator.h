@@ -0,0 +1,232 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_NODE_ALLOCATOR_H_
+#define ALGORITHMS_TREES_NODE_ALLOCATOR_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace trees::detail {
+
+// Releases every child from its parent before handing the parent to dispose, so tearing down a
+// subtree never recurses through the owning pointers.
+template<typename NodePointer, typename Dispose>
+void dispose_subtree(NodePointer root, Dispose dispose) {
+  std::vector<typename NodePointer::pointer> pending;
+  if (root)
+    pending.push_back(root.release());
+  while (!pending.empty()) {
+    auto node = pending.back();
+    pending.pop_back();
+    if (auto left = node->left_move().release())
+      pending.push_back(left);
+    if (auto right = node->right_move().release())
+      pending.push_back(right);
+    dispose(node);
+  }
+}
+
+template<typename NodeType>
+class HeapNodeAllocator {
+ public:
+  using pointer = std::unique_ptr<NodeType>;
+
+  // Whether nodes can be released from several threads at once.
+  static constexpr bool thread_safe = true;
+
+  template<typename... Args>
+  inline pointer make(Args &&... args) {
+    return std::make_unique<NodeType>(std::forward<Args>(args)...);
+  }
+
+  template<typename... Args>
+  static inline pointer make_near(NodeType const *, Args &&... args) {
+    return std::make_unique<NodeType>(std::forward<Args>(args)...);
+  }
+
+  inline void clear(pointer root) {
+    dispose_subtree(std::move(root), [](NodeType *node) { delete node; });
+  }
+
+  // Called before taking over nodes made by other.
+  inline void adopt(HeapNodeAllocator &) {}
+};
+
+// Carves nodes out of chunks aligned to their own size, so the chunk header (and the arena that
+// owns it) can be recovered from any node address. That keeps the deleter stateless, letting
+// pointer stay as small as a plain std::unique_ptr.
+template<typename NodeType>
+class SlabNodeAllocator {
+  class Arena;
+
+ public:
+  static constexpr std::size_t chunk_size = 64 * 1024;
+
+  struct Deleter {
+    inline void operator()(NodeType *node) const {
+      node->~NodeType();
+      Arena::of(node)->deallocate(node);
+    }
+  };
+  using pointer = std::unique_ptr<NodeType, Deleter>;
+
+  static constexpr bool thread_safe = false;
+
+  inline SlabNodeAllocator() = default;
+  inline SlabNodeAllocator(SlabNodeAllocator &&src) noexcept = default;
+  inline SlabNodeAllocator &operator=(SlabNodeAllocator &&src) noexcept = default;
+
+  template<typename... Args>
+  inline pointer make(Args &&... args) {
+    if (!arena_)
+      arena_ = std::make_shared<Arena>();
+    return arena_->make(std::forward<Args>(args)...);
+  }
+
+  template<typename... Args>
+  static inline pointer make_near(NodeType const *node, Args &&... args) {
+    return Arena::of(node)->make(std::forward<Args>(args)...);
+  }
+
+  inline void clear(pointer root) {
+    if (!arena_ || arena_.use_count() > 1 || !adopted_.empty()) {
+      dispose_subtree(std::move(root), Deleter{});
+      adopted_.clear();
+      return;
+    }
+    if constexpr (std::is_trivially_destructible_v<typename NodeType::value_type>)
+      root.release();
+    else
+      dispose_subtree(std::move(root), [](NodeType *node) { std::destroy_at(node); });
+    arena_->reset();
+  }
+
+  // Keeps the arenas of other alive while nodes made there live here. New nodes still come from
+  // our own arena, but releasing an adopted node touches its arena, so trees sharing arenas this
+  // way must not be modified concurrently.
+  inline void adopt(SlabNodeAllocator &other) {
+    if (other.arena_)
+      adopted_.push_back(other.arena_);
+    adopted_.insert(adopted_.end(), other.adopted_.begin(), other.adopted_.end());
+  }
+
+ private:
+  std::shared_ptr<Arena> arena_;
+  std::vector<std::shared_ptr<Arena>> adopted_;
+
+  class Arena {
+    struct Chunk {
+      Arena *owner;
+      Chunk *next;
+    };
+    struct FreeSlot {
+      FreeSlot *next;
+    };
+
+   public:
+    inline Arena() : chunks_{nullptr}, free_{nullptr}, cursor_{nullptr}, limit_{nullptr} {}
+    Arena(Arena const &) = delete;
+    Arena &operator=(Arena const &) = delete;
+    inline ~Arena() { reset(); }
+
+    static inline Arena *of(NodeType const *node) {
+      auto address = reinterpret_cast<std::uintptr_t>(node) & ~(std::uintptr_t{chunk_size} - 1);
+      return reinterpret_cast<Chunk *>(address)->owner;
+    }
+
+    template<typename... Args>
+    inline pointer make(Args &&... args) {
+      void *slot = allocate();
+      try {
+        return pointer(::new(slot) NodeType(std::forward<Args>(args)...));
+      } catch (...) {
+        deallocate(slot);
+        throw;
+      }
+    }
+
+    inline void deallocate(void *slot) {
+      free_ = ::new(slot) FreeSlot{free_};
+    }
+
+    inline void reset() {
+      while (chunks_) {
+        auto next = chunks_->next;
+        ::operator delete(chunks_, std::align_val_t{chunk_size});
+        chunks_ = next;
+      }
+      free_ = nullptr;
+      cursor_ = limit_ = nullptr;
+    }
+
+   private:
+    Chunk *chunks_;
+    FreeSlot *free_;
+    std::byte *cursor_;
+    std::byte *limit_;
+
+    static constexpr std::size_t slot_align() {
+      return std::max(alignof(NodeType), alignof(FreeSlot));
+    }
+
+    static constexpr std::size_t slot_size() {
+      auto size = std::max(sizeof(NodeType), sizeof(FreeSlot));
+      return (size + slot_align() - 1) / slot_align() * slot_align();
+    }
+
+    static constexpr std::size_t header_size() {
+      return (sizeof(Chunk) + slot_align() - 1) / slot_align() * slot_align();
+    }
+
+    inline void *allocate() {
+      if (free_) {
+        auto slot = free_;
+        free_ = slot->next;
+        return slot;
+      }
+      if (cursor_ == limit_)
+        grow();
+      auto slot = cursor_;
+      cursor_ += slot_size();
+      return slot;
+    }
+
+    inline void grow() {
+      static_assert(header_size() + slot_size() <= chunk_size, "node does not fit in a chunk");
+      auto memory = static_cast<std::byte *>(::operator new(chunk_size, std::align_val_t{chunk_size}));
+      chunks_ = ::new(memory) Chunk{this, chunks_};
+      cursor_ = memory + header_size();
+      limit_ = cursor_ + (chunk_size - header_size()) / slot_size() * slot_size();
+    }
+  };
+};
+
+}
+#endif //ALGORITHMS_TREES_NODE_ALLOCATOR_H_
@@ -0,0 +1,125 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_RB_RBTREE_H_
+#define ALGORITHMS_TREES_RB_RBTREE_H_
+
+#include <memory>
+#include <trees/bst.h>
+
+namespace trees::rb {
+
+namespace detail {
+
+template<typename T, template<typename> class Allocator = trees::detail::HeapNodeAllocator>
+struct RBNodeTraits;
+
+template<typename T, typename NodeTraits = rb::detail::RBNodeTraits<T>>
+class RBNode : public trees::detail::BSTNode<T, NodeTraits> {
+  using NodeType = typename NodeTraits::NodeType;
+ public:
+  using pointer = typename trees::detail::BSTNode<T, NodeTraits>::pointer;
+
+  inline explicit RBNode(T &&data,
+                         NodeType *parent = nullptr,
+                         pointer left = nullptr,
+                         pointer right = nullptr)
+      : trees::detail::BSTNode<T, NodeTraits>(std::forward<T>(data),
+                                              parent,
+                                              std::move(left),
+                                              std::move(right)),
+        red_{true} {}
+
+  inline RBNode(RBNode const &src,
+                NodeType *parent) : trees::detail::BSTNode<T, NodeTraits>(src, parent),
+                                    red_{src.red_} {}
+
+  [[nodiscard]] inline bool red() const { return red_; }
+  inline void red(bool value) { red_ = value; }
+
+  // Missing children count as black leaves.
+  [[nodiscard]] static inline bool is_red(NodeType const *node) { return node && node->red(); }
+
+  [[nodiscard]] inline bool operator==(NodeType const &other) const {
+    return trees::detail::BSTNode<T, NodeTraits>::operator==(other) && red() == other.red();
+  }
+ private:
+  bool red_;
+};
+
+template<typename T, template<typename> class Allocator>
+struct RBNodeTraits {
+  using NodeType = typename trees::rb::detail::RBNode<T, RBNodeTraits>;
+  using allocator_type = Allocator<NodeType>;
+};
+
+}
+
+// Red-black tree on the BST node framework. Its looser balance, height at most 2 log2(n + 1)
+// against 1.44 log2(n) for AVL, lets insert rotate at most twice and erase at most three times,
+// where AVL erase may rotate at every level up to the root.
+template<typename T, typename Comparator = std::less<T>, typename NodeType = detail::RBNode<T>>
+class RBTree : public BST<T, Comparator, NodeType> {
+ public:
+  using iterator = typename BST<T, Comparator, NodeType>::iterator;
+  using const_iterator = typename BST<T, Comparator, NodeType>::const_iterator;
+  using value_type = typename BST<T, Comparator, NodeType>::value_type;
+  using BST<T, Comparator, NodeType>::erase;
+
+  inline explicit RBTree(Comparator const &comp = Comparator()) : BST<T, Comparator, NodeType>(comp) {}
+  inline RBTree(RBTree &&src) noexcept: BST<T, Comparator, NodeType>(std::move(src)) {}
+  inline RBTree(RBTree const &src) : BST<T, Comparator, NodeType>(src) {}
+
+  std::pair<iterator, bool> insert(value_type value) override;
+  iterator insert(const_iterator hint, value_type value) override;
+  iterator erase(const_iterator position) override;
+  iterator erase(const_iterator first, const_iterator last) override;
+
+  // Like BST::assign_sorted, coloring the last level red when it is not full.
+  template<typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last);
+
+  // Rotations made by insert and erase so far, for comparing balancing schemes.
+  [[nodiscard]] inline std::size_t rotations() const { return rotations_; }
+
+ private:
+  std::size_t rotations_ = 0;
+
+  NodeType *rotate_left(NodeType *subroot, NodeType *right);
+  NodeType *rotate_right(NodeType *subroot, NodeType *left);
+
+  static void paint(NodeType *node, int depth, int red_depth);
+  void fix_insert(NodeType *node);
+  // Restores the black height of the subtree on the left or right of parent, which lost one black
+  // node.
+  void fix_erase(NodeType *parent, bool left);
+};
+
+template<typename T, typename Comparator = std::less<T>>
+using SlabRBTree = RBTree<T,
+                          Comparator,
+                          detail::RBNode<T, detail::RBNodeTraits<T, trees::detail::SlabNodeAllocator>>>;
+
+}
+#endif //ALGORITHMS_TREES_RB_RBTREE_H_
@@ -0,0 +1,234 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_RB_RBTREE_IPP_
+#define ALGORITHMS_TREES_RB_RBTREE_IPP_
+
+#include <bit>
+#include <iterator>
+#include <trees/rb/rb_tree.h>
+#include <trees/bst.ipp>
+
+namespace trees::rb {
+
+template<typename T, typename Comparator, typename NodeType>
+std::pair<typename RBTree<T, Comparator, NodeType>::iterator, bool>
+RBTree<T, Comparator, NodeType>::insert(value_type value) {
+  auto[itr, success] = BST<T, Comparator, NodeType>::insert(std::move(value), this->root());
+  if (success) {
+    fix_insert(this->current(itr));
+    this->update_path_augmented(this->current(itr));
+  }
+  return std::make_pair(itr, success);
+}
+
+template<typename T, typename Comparator, typename NodeType>
+typename RBTree<T, Comparator, NodeType>::iterator
+RBTree<T, Comparator, NodeType>::insert(const_iterator hint, value_type value) {
+  auto[itr, success] = this->insert_hinted(hint, std::move(value));
+  if (success) {
+    fix_insert(this->current(itr));
+    this->update_path_augmented(this->current(itr));
+  }
+  return itr;
+}
+
+template<typename T, typename Comparator, typename NodeType>
+typename RBTree<T, Comparator, NodeType>::iterator
+RBTree<T, Comparator, NodeType>::erase(const_iterator position) {
+  if (position == this->end())
+    return this->end();
+  auto node = this->current(position);
+  if (node->left() && node->right()) {
+    auto next = node->right()->leftmost();
+    node->data(std::move(next->data_move()));
+    erase(const_iterator(next));
+    return iterator(node);
+  }
+  auto itr = ++iterator(node);
+  auto parent = node->parent();
+  auto left = parent && parent->child_is_left(node);
+  auto removed_black = !node->red();
+  auto child = node->left() ? node->left_move() : node->right_move();
+  auto child_node = child.get();
+  // Replacing the owning pointer of node frees it.
+  if (!parent) {
+    this->root(std::move(child));
+    if (child_node)
+      child_node->parent(nullptr);
+  } else if (left) {
+    parent->left(std::move(child));
+  } else {
+    parent->right(std::move(child));
+  }
+  this->size(this->size() - 1);
+  if (removed_black) {
+    if (NodeType::is_red(child_node))
+      child_node->red(false);
+    else if (parent)
+      fix_erase(parent, left);
+  }
+  this->update_path_augmented(parent);
+  return itr;
+}
+
+// Erasing a node with two children moves the next element into it, which keeps the iterator
+// returned by erase valid, but not necessarily last, so the range is counted upfront.
+template<typename T, typename Comparator, typename NodeType>
+typename RBTree<T, Comparator, NodeType>::iterator
+RBTree<T, Comparator, NodeType>::erase(const_iterator first, const_iterator last) {
+  auto count = std::distance(first, last);
+  iterator itr(this->current(first));
+  while (count-- > 0)
+    itr = erase(itr);
+  return itr;
+}
+
+// Every level above the last is full, so painting the last one red, or no level when it is full
+// as well, leaves the same number of black nodes on every path.
+template<typename T, typename Comparator, typename NodeType>
+template<typename ForwardIt>
+void RBTree<T, Comparator, NodeType>::assign_sorted(ForwardIt first, ForwardIt last) {
+  BST<T, Comparator, NodeType>::assign_sorted(first, last);
+  auto size = this->size();
+  auto red_depth = (size & (size + 1)) ? static_cast<int>(std::bit_width(size)) - 1 : -1;
+  paint(this->root(), 0, red_depth);
+}
+
+template<typename T, typename Comparator, typename NodeType>
+void RBTree<T, Comparator, NodeType>::paint(NodeType *node, int depth, int red_depth) {
+  if (!node)
+    return;
+  node->red(depth == red_depth);
+  paint(node->left(), depth + 1, red_depth);
+  paint(node->right(), depth + 1, red_depth);
+}
+
+template<typename T, typename Comparator, typename NodeType>
+void RBTree<T, Comparator, NodeType>::fix_insert(NodeType *node) {
+  while (node->parent() && node->parent()->red()) {
+    auto parent = node->parent();
+    // A red parent is never the root, so the grandparent exists.
+    auto grandparent = parent->parent();
+    auto parent_left = grandparent->child_is_left(parent);
+    auto uncle = parent_left ? grandparent->right() : grandparent->left();
+    if (NodeType::is_red(uncle)) {
+      parent->red(false);
+      uncle->red(false);
+      grandparent->red(true);
+      node = grandparent;
+      continue;
+    }
+    if (parent_left) {
+      if (parent->child_is_right(node))
+        parent = rotate_left(parent, node);
+      rotate_right(grandparent, parent);
+    } else {
+      if (parent->child_is_left(node))
+        parent = rotate_right(parent, node);
+      rotate_left(grandparent, parent);
+    }
+    parent->red(false);
+    grandparent->red(true);
+    break;
+  }
+  this->root()->red(false);
+}
+
+template<typename T, typename Comparator, typename NodeType>
+void RBTree<T, Comparator, NodeType>::fix_erase(NodeType *parent, bool left) {
+  while (parent) {
+    // The shorter side is missing a black node, so the other side holds at least one.
+    auto sibling = left ? parent->right() : parent->left();
+    if (sibling->red()) {
+      sibling->red(false);
+      parent->red(true);
+      if (left)
+        rotate_left(parent, sibling);
+      else
+        rotate_right(parent, sibling);
+      sibling = left ? parent->right() : parent->left();
+    }
+    auto near = left ? sibling->left() : sibling->right();
+    auto far = left ? sibling->right() : sibling->left();
+    if (!NodeType::is_red(near) && !NodeType::is_red(far)) {
+      sibling->red(true);
+      if (parent->red()) {
+        parent->red(false);
+        return;
+      }
+      auto node = parent;
+      parent = node->parent();
+      left = parent && parent->child_is_left(node);
+      continue;
+    }
+    if (!NodeType::is_red(far)) {
+      near->red(false);
+      sibling->red(true);
+      if (left)
+        rotate_right(sibling, near);
+      else
+        rotate_left(sibling, near);
+      far = sibling;
+      sibling = near;
+    }
+    sibling->red(parent->red());
+    parent->red(false);
+    far->red(false);
+    if (left)
+      rotate_left(parent, sibling);
+    else
+      rotate_right(parent, sibling);
+    return;
+  }
+}
+
+template<typename T, typename Comparator, typename NodeType>
+NodeType *RBTree<T, Comparator, NodeType>::rotate_left(NodeType *subroot,
+                                                       NodeType *right) {
+  ++rotations_;
+  auto subroot_right = subroot->right_move();
+  subroot->right(right->left_move());
+  auto subroot_move = this->move_node_and_replace(subroot, std::move(subroot_right));
+  right->left(std::move(subroot_move));
+  subroot->update_augmented();
+  right->update_augmented();
+  return right;
+}
+
+template<typename T, typename Comparator, typename NodeType>
+NodeType *RBTree<T, Comparator, NodeType>::rotate_right(NodeType *subroot,
+                                                        NodeType *left) {
+  ++rotations_;
+  auto subroot_left = subroot->left_move();
+  subroot->left(left->right_move());
+  auto subroot_move = this->move_node_and_replace(subroot, std::move(subroot_left));
+  left->right(std::move(subroot_move));
+  subroot->update_augmented();
+  left->update_augmented();
+  return left;
+}
+
+}
+#endif //ALGORITHMS_TREES_RB_RBTREE_IPP_
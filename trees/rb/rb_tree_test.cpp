@@ -0,0 +1,185 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <trees/rb/rb_tree.h>
+#include <trees/rb/rb_tree.ipp>
+#include <trees/avl/avl_tree.h>
+#include <trees/avl/avl_tree.ipp>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace trees::rb::test {
+
+namespace {
+
+// Exposes the root so the tests can check the coloring rules node by node.
+template<typename Tree>
+struct InspectableTree : Tree {
+  using Tree::root;
+};
+
+// Black height of node, or -1 when the subtree breaks a red-black rule.
+template<typename NodeType>
+int black_height(NodeType const *node, NodeType const *parent) {
+  if (!node)
+    return 1;
+  if (node->parent() != parent)
+    return -1;
+  if (node->red() && (NodeType::is_red(node->left()) || NodeType::is_red(node->right())))
+    return -1;
+  auto left = black_height(node->left(), node);
+  auto right = black_height(node->right(), node);
+  if (left < 0 || left != right)
+    return -1;
+  return left + !node->red();
+}
+
+template<typename Tree>
+void expect_valid_rb(Tree const &tree, std::set<int> const &expected) {
+  ASSERT_EQ(tree.size(), expected.size());
+  EXPECT_TRUE(std::equal(tree.begin(), tree.end(), expected.begin(), expected.end()));
+  auto root = tree.root();
+  if (!root)
+    return;
+  EXPECT_FALSE(root->red());
+  EXPECT_GT(black_height(root, static_cast<decltype(root)>(nullptr)), 0);
+  EXPECT_LE(tree.height(), 2 * std::log2(expected.size() + 1));
+}
+
+}
+
+TEST(RBTree, random_insert_and_erase_keeps_invariants) {
+  std::default_random_engine generator(37);
+  std::uniform_int_distribution<int> distribution(0, 3000);
+  InspectableTree<RBTree<int>> tree;
+  std::set<int> expected;
+  for (int i = 0; i < 20000; ++i) {
+    auto number = distribution(generator);
+    if (i % 3 == 2)
+      EXPECT_EQ(tree.erase(number), expected.erase(number));
+    else
+      EXPECT_EQ(tree.insert(number).second, expected.insert(number).second);
+    if (i % 1000 == 0)
+      expect_valid_rb(tree, expected);
+  }
+  expect_valid_rb(tree, expected);
+  for (auto number : std::vector<int>(expected.begin(), expected.end())) {
+    tree.erase(number);
+    expected.erase(number);
+  }
+  expect_valid_rb(tree, expected);
+}
+
+TEST(RBTree, hinted_insert_and_range_erase) {
+  InspectableTree<SlabRBTree<int>> tree;
+  std::set<int> expected;
+  for (int i = 0; i < 5000; ++i) {
+    tree.insert(tree.end(), i);
+    expected.insert(i);
+  }
+  expect_valid_rb(tree, expected);
+  auto itr = tree.erase(tree.find(1000), tree.find(4000));
+  expected.erase(expected.find(1000), expected.find(4000));
+  EXPECT_EQ(*itr, 4000);
+  expect_valid_rb(tree, expected);
+  tree.erase(tree.begin(), tree.end());
+  expected.clear();
+  expect_valid_rb(tree, expected);
+}
+
+TEST(RBTree, assign_sorted_keeps_invariants) {
+  InspectableTree<RBTree<int>> tree;
+  std::set<int> expected;
+  for (int size = 0; size < 70; ++size) {
+    std::vector<int> numbers(size);
+    std::iota(numbers.begin(), numbers.end(), 0);
+    tree.assign_sorted(numbers.begin(), numbers.end());
+    expected = std::set<int>(numbers.begin(), numbers.end());
+    expect_valid_rb(tree, expected);
+  }
+  for (int i = 0; i < 70; i += 3) {
+    tree.erase(i);
+    expected.erase(i);
+  }
+  expect_valid_rb(tree, expected);
+}
+
+TEST(RBTree, rotations_per_update_are_bounded) {
+  std::default_random_engine generator(41);
+  std::uniform_int_distribution<int> distribution(0, 1 << 16);
+  RBTree<int> tree;
+  for (int i = 0; i < 50000; ++i) {
+    auto number = distribution(generator);
+    auto before = tree.rotations();
+    if (i % 2)
+      tree.erase(number);
+    else
+      tree.insert(number);
+    ASSERT_LE(tree.rotations() - before, i % 2 ? 3 : 2);
+  }
+}
+
+TEST(RBTree, benchmark_mixed_workload_against_avl) {
+  std::size_t operations = 1 << 19;
+  std::default_random_engine generator(43);
+  std::uniform_int_distribution<int> distribution(0, 1 << 16);
+  std::vector<int> keys(operations);
+  for (auto &key : keys)
+    key = distribution(generator);
+
+  auto run = [&](auto &tree) {
+    std::size_t found = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; i < operations; ++i) {
+      // Erase-heavy: as many erases as inserts, plus one lookup for each.
+      if (i % 4 < 2)
+        tree.insert(keys[i]);
+      else if (i % 4 == 2)
+        tree.erase(keys[i - 2]);
+      else
+        found += tree.find(keys[i]) != tree.end();
+    }
+    auto finish = std::chrono::high_resolution_clock::now();
+    return std::make_pair(std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count(), found);
+  };
+
+  RBTree<int> rb_tree;
+  avl::AVLTree<int> avl_tree;
+  auto[rb_us, rb_found] = run(rb_tree);
+  auto[avl_us, avl_found] = run(avl_tree);
+  EXPECT_EQ(rb_found, avl_found);
+  EXPECT_TRUE(std::equal(rb_tree.begin(), rb_tree.end(), avl_tree.begin(), avl_tree.end()));
+  std::cout << "mixed workload RBTree: " << rb_us << "us " << rb_tree.rotations() << " rotations, height "
+            << rb_tree.height() << std::endl;
+  std::cout << "mixed workload AVLTree: " << avl_us << "us " << avl_tree.rotations() << " rotations, height "
+            << avl_tree.height() << std::endl;
+}
+
+}
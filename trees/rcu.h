@@ -0,0 +1,88 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_RCU_H_
+#define ALGORITHMS_TREES_RCU_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>
+
+namespace trees::detail {
+
+// Read-copy-update grace periods. Readers bump a counter tagged with the current phase on entry
+// and drop it on exit; synchronize flips the phase and waits for the previous phase's readers to
+// drain, after which nothing unpublished before the call can still be referenced. Counters are
+// striped per thread so readers on different cores do not share a cache line.
+class ReadCopyUpdate {
+  static constexpr std::size_t stripes = 64;
+
+  struct alignas(64) Stripe {
+    std::array<std::atomic<std::size_t>, 2> readers{};
+  };
+
+ public:
+  class ReadGuard {
+   public:
+    inline explicit ReadGuard(ReadCopyUpdate const &rcu)
+        : counter_{&rcu.stripes_[stripe()].readers[rcu.phase_.load() & 1]} {
+      counter_->fetch_add(1);
+    }
+    ReadGuard(ReadGuard const &) = delete;
+    ReadGuard &operator=(ReadGuard const &) = delete;
+    inline ~ReadGuard() { counter_->fetch_sub(1, std::memory_order_release); }
+
+   private:
+    std::atomic<std::size_t> *counter_;
+  };
+
+  [[nodiscard]] inline ReadGuard read_lock() const { return ReadGuard{*this}; }
+
+  // Callers must serialize synchronize among themselves. A reader may read the phase just before
+  // a flip and register under it just after the wait checked its stripe, so one flip can miss it;
+  // flipping twice drains both phases and with them every reader that predates the call.
+  inline void synchronize() {
+    for (int flip = 0; flip < 2; ++flip) {
+      auto previous = phase_.fetch_add(1) & 1;
+      for (auto &stripe : stripes_) {
+        while (stripe.readers[previous].load() != 0)
+          std::this_thread::yield();
+      }
+    }
+  }
+
+ private:
+  mutable std::array<Stripe, stripes> stripes_;
+  std::atomic<std::size_t> phase_{0};
+
+  static inline std::size_t stripe() {
+    thread_local std::size_t index = std::hash<std::thread::id>{}(std::this_thread::get_id()) % stripes;
+    return index;
+  }
+};
+
+}
+#endif //ALGORITHMS_TREES_RCU_H_
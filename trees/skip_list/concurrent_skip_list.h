@@ -0,0 +1,125 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_SKIP_LIST_CONCURRENT_SKIP_LIST_H_
+#define ALGORITHMS_TREES_SKIP_LIST_CONCURRENT_SKIP_LIST_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <trees/rcu.h>
+
+namespace trees {
+
+// Lock-free skip list set for any number of concurrent readers and writers. Links carry a mark
+// bit: erase marks a node's links top-down, and whoever marks level 0 owns the removal. Searches
+// unlink marked nodes they pass with a compare-and-swap, so searching, inserting and erasing never
+// wait on one another. Only reclamation blocks: unlinked nodes are freed in batches once a grace
+// period shows no operation can still hold them, and the insert or erase that frees a batch waits
+// for every operation and for_each already running to finish.
+template<typename T, typename Comparator = std::less<T>>
+class ConcurrentSkipList {
+ public:
+  using value_type = T;
+
+  static constexpr int max_level = 16;
+
+  explicit ConcurrentSkipList(Comparator comp = Comparator());
+  ConcurrentSkipList(ConcurrentSkipList const &) = delete;
+  ConcurrentSkipList &operator=(ConcurrentSkipList const &) = delete;
+  ~ConcurrentSkipList();
+
+  bool insert(value_type value);
+  std::size_t erase(value_type const &value);
+
+  [[nodiscard]] inline std::size_t size() const { return size_.load(std::memory_order_relaxed); }
+  [[nodiscard]] bool contains(value_type const &value) const;
+  [[nodiscard]] std::optional<value_type> find(value_type const &value) const;
+  [[nodiscard]] std::optional<value_type> lower_bound(value_type const &value) const;
+
+  // Visits the elements in order. Elements inserted or erased meanwhile may or may not be seen.
+  // A long visit stalls whichever writer reclaims meanwhile, and function must not insert or
+  // erase: that writer could end up waiting for the visit it runs in.
+  template<typename Function>
+  void for_each(Function function) const;
+
+ private:
+  struct Tower {
+    int height;
+    std::atomic<std::uintptr_t> *links;
+  };
+
+  // The links sit right after the node, in the same allocation.
+  struct Node : Tower {
+    T value;
+    // One share for the inserter while it links the upper levels and one for the list, dropped by
+    // the erase that marks level 0. The last to let go unlinks and retires the node.
+    std::atomic<int> owners;
+    Node *retired_next;
+
+    Node(T &&value, int height);
+  };
+
+  using Path = std::pair<std::array<Tower *, max_level>, std::array<Node *, max_level>>;
+
+  static constexpr std::uintptr_t mark = 1;
+  static constexpr std::size_t retire_batch = 1024;
+
+  Comparator comp_;
+  std::array<std::atomic<std::uintptr_t>, max_level> head_links_;
+  Tower head_;
+  std::atomic<std::size_t> size_;
+  detail::ReadCopyUpdate rcu_;
+  std::atomic<Node *> retired_;
+  std::atomic<std::size_t> retired_count_;
+  std::mutex reclaimer_;
+
+  static inline Node *pointer(std::uintptr_t link) { return reinterpret_cast<Node *>(link & ~mark); }
+  static inline std::uintptr_t link(Node *node) { return reinterpret_cast<std::uintptr_t>(node); }
+  static inline bool marked(std::uintptr_t link) { return link & mark; }
+
+  static Node *make(T &&value, int height);
+  static void destroy(Node *node);
+  static int random_height();
+
+  // Fills path with the last node before value and the first one not before it on every level,
+  // unlinking marked nodes on the way. Returns whether the latter is value on level 0.
+  bool find_path(value_type const &value, Path &path);
+  [[nodiscard]] std::optional<bool> try_find_path(value_type const &value, Path &path);
+  [[nodiscard]] Node *lower_bound_node(value_type const &value) const;
+
+  bool insert_node(value_type &value);
+  bool link_level(Node *node, int level, Path &path);
+  std::size_t erase_node(value_type const &value);
+  void release(Node *node);
+  void retire(Node *node);
+  void reclaim();
+};
+
+}
+#endif //ALGORITHMS_TREES_SKIP_LIST_CONCURRENT_SKIP_LIST_H_
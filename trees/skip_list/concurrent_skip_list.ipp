@@ -0,0 +1,314 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_SKIP_LIST_CONCURRENT_SKIP_LIST_IPP_
+#define ALGORITHMS_TREES_SKIP_LIST_CONCURRENT_SKIP_LIST_IPP_
+
+#include <algorithm>
+#include <bit>
+#include <new>
+#include <thread>
+#include <trees/skip_list/concurrent_skip_list.h>
+
+namespace trees {
+
+template<typename T, typename Comparator>
+ConcurrentSkipList<T, Comparator>::Node::Node(T &&value, int height)
+    : Tower{height, reinterpret_cast<std::atomic<std::uintptr_t> *>(this + 1)},
+      value{std::move(value)},
+      owners{2},
+      retired_next{nullptr} {
+  for (int level = 0; level < height; ++level)
+    ::new(this->links + level) std::atomic<std::uintptr_t>{0};
+}
+
+template<typename T, typename Comparator>
+ConcurrentSkipList<T, Comparator>::ConcurrentSkipList(Comparator comp)
+    : comp_{comp}, head_links_{}, head_{max_level, head_links_.data()}, size_{0}, retired_{nullptr},
+      retired_count_{0} {}
+
+// No operation can be running, so every node is either still on level 0 or retired.
+template<typename T, typename Comparator>
+ConcurrentSkipList<T, Comparator>::~ConcurrentSkipList() {
+  for (auto node = pointer(head_links_[0].load()); node;) {
+    auto next = pointer(node->links[0].load());
+    destroy(node);
+    node = next;
+  }
+  for (auto node = retired_.load(); node;) {
+    auto next = node->retired_next;
+    destroy(node);
+    node = next;
+  }
+}
+
+template<typename T, typename Comparator>
+typename ConcurrentSkipList<T, Comparator>::Node *ConcurrentSkipList<T, Comparator>::make(T &&value, int height) {
+  auto memory = ::operator new(sizeof(Node) + height * sizeof(std::atomic<std::uintptr_t>),
+                               std::align_val_t{alignof(Node)});
+  try {
+    return ::new(memory) Node(std::move(value), height);
+  } catch (...) {
+    ::operator delete(memory, std::align_val_t{alignof(Node)});
+    throw;
+  }
+}
+
+template<typename T, typename Comparator>
+void ConcurrentSkipList<T, Comparator>::destroy(Node *node) {
+  node->~Node();
+  ::operator delete(node, std::align_val_t{alignof(Node)});
+}
+
+template<typename T, typename Comparator>
+int ConcurrentSkipList<T, Comparator>::random_height() {
+  thread_local std::uint64_t random = std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1;
+  random ^= random << 13;
+  random ^= random >> 7;
+  random ^= random << 17;
+  return std::min(max_level, 1 + std::countr_zero(random) / 2);
+}
+
+template<typename T, typename Comparator>
+bool ConcurrentSkipList<T, Comparator>::insert(value_type value) {
+  bool res;
+  {
+    auto guard = rcu_.read_lock();
+    res = insert_node(value);
+  }
+  reclaim();
+  return res;
+}
+
+template<typename T, typename Comparator>
+std::size_t ConcurrentSkipList<T, Comparator>::erase(value_type const &value) {
+  std::size_t res;
+  {
+    auto guard = rcu_.read_lock();
+    res = erase_node(value);
+  }
+  reclaim();
+  return res;
+}
+
+template<typename T, typename Comparator>
+bool ConcurrentSkipList<T, Comparator>::contains(value_type const &value) const {
+  auto guard = rcu_.read_lock();
+  auto node = lower_bound_node(value);
+  return node && !comp_(value, node->value);
+}
+
+template<typename T, typename Comparator>
+std::optional<T> ConcurrentSkipList<T, Comparator>::find(value_type const &value) const {
+  auto guard = rcu_.read_lock();
+  auto node = lower_bound_node(value);
+  if (!node || comp_(value, node->value))
+    return std::nullopt;
+  return node->value;
+}
+
+template<typename T, typename Comparator>
+std::optional<T> ConcurrentSkipList<T, Comparator>::lower_bound(value_type const &value) const {
+  auto guard = rcu_.read_lock();
+  auto node = lower_bound_node(value);
+  if (!node)
+    return std::nullopt;
+  return node->value;
+}
+
+template<typename T, typename Comparator>
+template<typename Function>
+void ConcurrentSkipList<T, Comparator>::for_each(Function function) const {
+  auto guard = rcu_.read_lock();
+  for (auto node = pointer(head_links_[0].load()); node;) {
+    auto next = node->links[0].load();
+    if (!marked(next))
+      function(static_cast<T const &>(node->value));
+    node = pointer(next);
+  }
+}
+
+// Readers pass through marked nodes instead of unlinking them; they stay valid until reclaimed.
+template<typename T, typename Comparator>
+typename ConcurrentSkipList<T, Comparator>::Node *
+ConcurrentSkipList<T, Comparator>::lower_bound_node(value_type const &value) const {
+  Tower const *pred = &head_;
+  Node *curr = nullptr;
+  for (int level = max_level - 1; level >= 0; --level) {
+    curr = pointer(pred->links[level].load());
+    while (curr && comp_(curr->value, value)) {
+      pred = curr;
+      curr = pointer(curr->links[level].load());
+    }
+  }
+  while (curr && marked(curr->links[0].load()))
+    curr = pointer(curr->links[0].load());
+  return curr;
+}
+
+template<typename T, typename Comparator>
+bool ConcurrentSkipList<T, Comparator>::find_path(value_type const &value, Path &path) {
+  while (true) {
+    if (auto found = try_find_path(value, path))
+      return *found;
+  }
+}
+
+// Gives up, for find_path to start over, when the node it would unlink from is itself unlinked
+// or marked, which makes its link compare-and-swap fail.
+template<typename T, typename Comparator>
+std::optional<bool> ConcurrentSkipList<T, Comparator>::try_find_path(value_type const &value, Path &path) {
+  auto &[preds, succs] = path;
+  Tower *pred = &head_;
+  for (int level = max_level - 1; level >= 0; --level) {
+    auto curr = pointer(pred->links[level].load());
+    while (curr) {
+      auto succ = curr->links[level].load();
+      if (marked(succ)) {
+        auto expected = link(curr);
+        if (!pred->links[level].compare_exchange_strong(expected, succ & ~mark))
+          return std::nullopt;
+        curr = pointer(succ);
+        continue;
+      }
+      if (!comp_(curr->value, value))
+        break;
+      pred = curr;
+      curr = pointer(succ);
+    }
+    preds[level] = pred;
+    succs[level] = curr;
+  }
+  return succs[0] && !comp_(value, succs[0]->value);
+}
+
+template<typename T, typename Comparator>
+bool ConcurrentSkipList<T, Comparator>::insert_node(value_type &value) {
+  Path path;
+  if (find_path(value, path))
+    return false;
+  auto height = random_height();
+  auto node = make(std::move(value), height);
+  while (true) {
+    for (int level = 0; level < height; ++level)
+      node->links[level].store(link(path.second[level]), std::memory_order_relaxed);
+    auto expected = link(path.second[0]);
+    if (path.first[0]->links[0].compare_exchange_strong(expected, link(node)))
+      break;
+    if (find_path(node->value, path)) {
+      destroy(node);
+      return false;
+    }
+  }
+  size_.fetch_add(1, std::memory_order_relaxed);
+  for (int level = 1; level < height && link_level(node, level, path); ++level) {}
+  release(node);
+  return true;
+}
+
+// Links node on level, once it is on every level below. Returns false when an erase got to node
+// first, which marks the link first so this can never add it to a level again.
+template<typename T, typename Comparator>
+bool ConcurrentSkipList<T, Comparator>::link_level(Node *node, int level, Path &path) {
+  auto &[preds, succs] = path;
+  while (true) {
+    auto current = node->links[level].load();
+    if (marked(current))
+      return false;
+    if (current != link(succs[level]) && !node->links[level].compare_exchange_strong(current, link(succs[level])))
+      return false;
+    auto expected = link(succs[level]);
+    if (preds[level]->links[level].compare_exchange_strong(expected, link(node)))
+      return true;
+    find_path(node->value, path);
+    if (succs[0] != node)
+      return false;
+  }
+}
+
+template<typename T, typename Comparator>
+std::size_t ConcurrentSkipList<T, Comparator>::erase_node(value_type const &value) {
+  Path path;
+  if (!find_path(value, path))
+    return 0;
+  auto victim = path.second[0];
+  for (int level = victim->height - 1; level > 0; --level) {
+    auto succ = victim->links[level].load();
+    while (!marked(succ))
+      victim->links[level].compare_exchange_weak(succ, succ | mark);
+  }
+  auto succ = victim->links[0].load();
+  while (!marked(succ)) {
+    if (victim->links[0].compare_exchange_weak(succ, succ | mark)) {
+      find_path(value, path);
+      size_.fetch_sub(1, std::memory_order_relaxed);
+      release(victim);
+      return 1;
+    }
+  }
+  // Another erase marked it first and takes the credit.
+  return 0;
+}
+
+// Past both the level 0 mark and the last upper link, a search for the value unlinks node for
+// good: nothing links a node but its inserter.
+template<typename T, typename Comparator>
+void ConcurrentSkipList<T, Comparator>::release(Node *node) {
+  if (node->owners.fetch_sub(1) != 1)
+    return;
+  Path path;
+  find_path(node->value, path);
+  retire(node);
+}
+
+template<typename T, typename Comparator>
+void ConcurrentSkipList<T, Comparator>::retire(Node *node) {
+  node->retired_next = retired_.load();
+  while (!retired_.compare_exchange_weak(node->retired_next, node)) {}
+  retired_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Runs outside any read-side section, since synchronize waits for those. Other threads skip
+// reclaiming rather than wait while one is at it.
+template<typename T, typename Comparator>
+void ConcurrentSkipList<T, Comparator>::reclaim() {
+  if (retired_count_.load(std::memory_order_relaxed) < retire_batch)
+    return;
+  std::unique_lock lock{reclaimer_, std::try_to_lock};
+  if (!lock.owns_lock())
+    return;
+  auto node = retired_.exchange(nullptr);
+  rcu_.synchronize();
+  std::size_t count = 0;
+  while (node) {
+    auto next = node->retired_next;
+    destroy(node);
+    node = next;
+    ++count;
+  }
+  retired_count_.fetch_sub(count, std::memory_order_relaxed);
+}
+
+}
+#endif //ALGORITHMS_TREES_SKIP_LIST_CONCURRENT_SKIP_LIST_IPP_
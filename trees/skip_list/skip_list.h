@@ -0,0 +1,143 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_SKIP_LIST_SKIP_LIST_H_
+#define ALGORITHMS_TREES_SKIP_LIST_SKIP_LIST_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace trees {
+
+// Ordered set over a skip list: every element sits on level 0, a quarter of them also on level 1
+// and so on, so a search drops through O(log n) levels without any rebalancing. Insert and erase
+// only relink the neighbours of one node, which is what makes the lock-free ConcurrentSkipList
+// possible.
+template<typename T, typename Comparator = std::less<T>>
+class SkipList {
+  struct Node;
+
+ public:
+  using value_type = T;
+
+  static constexpr int max_level = 16;
+
+  explicit SkipList(Comparator comp = Comparator());
+  SkipList(SkipList &&src) noexcept;
+  SkipList(SkipList const &src);
+  ~SkipList();
+
+  template<bool is_const = true>
+  class base_iterator {
+    using list_type = std::conditional_t<is_const, SkipList const, SkipList>;
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::conditional_t<is_const, T const, T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<is_const, T const *, T *>;
+    using reference = std::conditional_t<is_const, T const &, T &>;
+
+    inline base_iterator(base_iterator<false> const &src) : base_iterator{src.list_, src.node_} {}
+    base_iterator &operator=(base_iterator const &) = default;
+
+    explicit base_iterator(SkipList const *list = nullptr, Node *node = nullptr);
+    base_iterator &operator++();
+    base_iterator operator++(int);
+    base_iterator &operator--();
+    base_iterator operator--(int);
+    [[nodiscard]] bool operator==(const base_iterator &other) const;
+    [[nodiscard]] bool operator!=(const base_iterator &other) const;
+    [[nodiscard]] reference operator*() const;
+    [[nodiscard]] inline pointer operator->() const { return &node_->value; }
+
+   private:
+    friend class base_iterator<!is_const>;
+    friend class SkipList;
+
+    SkipList const *list_;
+    Node *node_;
+  };
+
+  using iterator = base_iterator<false>;
+  using const_iterator = base_iterator<true>;
+
+  [[nodiscard]] inline iterator begin() { return iterator(this, head_[0]); }
+  [[nodiscard]] inline iterator end() { return iterator(this); }
+
+  [[nodiscard]] inline const_iterator begin() const { return const_iterator(this, head_[0]); }
+  [[nodiscard]] inline const_iterator end() const { return const_iterator(this); }
+
+  std::pair<iterator, bool> insert(value_type value);
+
+  iterator erase(const_iterator position);
+  std::size_t erase(value_type const &value);
+  iterator erase(const_iterator first, const_iterator last);
+  void clear();
+
+  [[nodiscard]] inline std::size_t size() const { return size_; }
+  [[nodiscard]] inline bool empty() const { return size_ == 0; }
+  // Highest level in use, counting level 0 as 1.
+  [[nodiscard]] inline int levels() const { return levels_; }
+  [[nodiscard]] const_iterator find(value_type const &value) const;
+  [[nodiscard]] iterator find(value_type const &value);
+  [[nodiscard]] const_iterator lower_bound(value_type const &value) const;
+  [[nodiscard]] iterator lower_bound(value_type const &value);
+  [[nodiscard]] const_iterator upper_bound(value_type const &value) const;
+  [[nodiscard]] iterator upper_bound(value_type const &value);
+
+ private:
+  // The forward links sit right after the node, in the same allocation.
+  struct Node {
+    T value;
+    Node *prev;
+    int height;
+
+    inline Node **next() { return reinterpret_cast<Node **>(this + 1); }
+  };
+
+  Comparator comp_;
+  std::size_t size_;
+  int levels_;
+  std::uint64_t random_;
+  std::array<Node *, max_level> head_;
+  Node *tail_;
+
+  static Node *make(T &&value, int height);
+  static void destroy(Node *node);
+  int random_height();
+  // Fills update with the last node before value on each level, or nullptr for the head.
+  void find_predecessors(value_type const &value, std::array<Node *, max_level> &update) const;
+  [[nodiscard]] Node *lower_bound_node(value_type const &value) const;
+  [[nodiscard]] inline Node *&next(Node *node, int level) { return node ? node->next()[level] : head_[level]; }
+  [[nodiscard]] inline Node *next(Node *node, int level) const { return node ? node->next()[level] : head_[level]; }
+  void unlink(Node *node, std::array<Node *, max_level> const &update);
+};
+
+}
+#endif //ALGORITHMS_TREES_SKIP_LIST_SKIP_LIST_H_
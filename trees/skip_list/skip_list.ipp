@@ -0,0 +1,306 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_SKIP_LIST_SKIP_LIST_IPP_
+#define ALGORITHMS_TREES_SKIP_LIST_SKIP_LIST_IPP_
+
+#include <algorithm>
+#include <bit>
+#include <new>
+#include <trees/skip_list/skip_list.h>
+
+namespace trees {
+
+template<typename T, typename Comparator>
+template<bool is_const>
+SkipList<T, Comparator>::base_iterator<is_const>::base_iterator(SkipList const *list, Node *node)
+    : list_{list}, node_{node} {}
+
+template<typename T, typename Comparator>
+template<bool is_const>
+typename SkipList<T, Comparator>::template base_iterator<is_const> &
+SkipList<T, Comparator>::base_iterator<is_const>::operator++() {
+  node_ = node_->next()[0];
+  return *this;
+}
+
+template<typename T, typename Comparator>
+template<bool is_const>
+typename SkipList<T, Comparator>::template base_iterator<is_const>
+SkipList<T, Comparator>::base_iterator<is_const>::operator++(int) {
+  base_iterator<is_const> retval = *this;
+  ++(*this);
+  return retval;
+}
+
+template<typename T, typename Comparator>
+template<bool is_const>
+typename SkipList<T, Comparator>::template base_iterator<is_const> &
+SkipList<T, Comparator>::base_iterator<is_const>::operator--() {
+  node_ = node_ ? node_->prev : list_->tail_;
+  return *this;
+}
+
+template<typename T, typename Comparator>
+template<bool is_const>
+typename SkipList<T, Comparator>::template base_iterator<is_const>
+SkipList<T, Comparator>::base_iterator<is_const>::operator--(int) {
+  base_iterator<is_const> retval = *this;
+  --(*this);
+  return retval;
+}
+
+template<typename T, typename Comparator>
+template<bool is_const>
+bool SkipList<T, Comparator>::base_iterator<is_const>::operator==(const base_iterator &other) const {
+  return node_ == other.node_;
+}
+
+template<typename T, typename Comparator>
+template<bool is_const>
+bool SkipList<T, Comparator>::base_iterator<is_const>::operator!=(const base_iterator &other) const {
+  return !(*this == other);
+}
+
+template<typename T, typename Comparator>
+template<bool is_const>
+typename SkipList<T, Comparator>::template base_iterator<is_const>::reference
+SkipList<T, Comparator>::base_iterator<is_const>::operator*() const {
+  return node_->value;
+}
+
+template<typename T, typename Comparator>
+SkipList<T, Comparator>::SkipList(Comparator comp)
+    : comp_{comp}, size_{0}, levels_{1}, random_{0x9e3779b97f4a7c15}, head_{}, tail_{nullptr} {}
+
+template<typename T, typename Comparator>
+SkipList<T, Comparator>::SkipList(SkipList &&src) noexcept
+    : comp_{src.comp_}, size_{src.size_}, levels_{src.levels_}, random_{src.random_}, head_{src.head_},
+      tail_{src.tail_} {
+  src.size_ = 0;
+  src.levels_ = 1;
+  src.head_ = {};
+  src.tail_ = nullptr;
+}
+
+// Appending in order, each level grows at its tail, which update tracks.
+template<typename T, typename Comparator>
+SkipList<T, Comparator>::SkipList(SkipList const &src)
+    : comp_{src.comp_}, size_{0}, levels_{src.levels_}, random_{src.random_}, head_{}, tail_{nullptr} {
+  std::array<Node *, max_level> update{};
+  for (auto node = src.head_[0]; node; node = node->next()[0]) {
+    auto copy = make(T(node->value), node->height);
+    for (int level = 0; level < copy->height; ++level) {
+      next(update[level], level) = copy;
+      update[level] = copy;
+    }
+    copy->prev = tail_;
+    tail_ = copy;
+    ++size_;
+  }
+}
+
+template<typename T, typename Comparator>
+SkipList<T, Comparator>::~SkipList() {
+  clear();
+}
+
+template<typename T, typename Comparator>
+typename SkipList<T, Comparator>::Node *SkipList<T, Comparator>::make(T &&value, int height) {
+  auto memory = ::operator new(sizeof(Node) + height * sizeof(Node *), std::align_val_t{alignof(Node)});
+  Node *node;
+  try {
+    node = ::new(memory) Node{std::move(value), nullptr, height};
+  } catch (...) {
+    ::operator delete(memory, std::align_val_t{alignof(Node)});
+    throw;
+  }
+  std::fill_n(node->next(), height, nullptr);
+  return node;
+}
+
+template<typename T, typename Comparator>
+void SkipList<T, Comparator>::destroy(Node *node) {
+  node->~Node();
+  ::operator delete(node, std::align_val_t{alignof(Node)});
+}
+
+// xorshift64; every two trailing zero bits promote the node one level, a 1/4 chance each.
+template<typename T, typename Comparator>
+int SkipList<T, Comparator>::random_height() {
+  random_ ^= random_ << 13;
+  random_ ^= random_ >> 7;
+  random_ ^= random_ << 17;
+  return std::min(max_level, 1 + std::countr_zero(random_) / 2);
+}
+
+template<typename T, typename Comparator>
+void SkipList<T, Comparator>::find_predecessors(value_type const &value,
+                                                std::array<Node *, max_level> &update) const {
+  Node *node = nullptr;
+  for (int level = levels_ - 1; level >= 0; --level) {
+    for (auto succ = next(node, level); succ && comp_(succ->value, value); succ = next(node, level))
+      node = succ;
+    update[level] = node;
+  }
+}
+
+template<typename T, typename Comparator>
+typename SkipList<T, Comparator>::Node *SkipList<T, Comparator>::lower_bound_node(value_type const &value) const {
+  Node *node = nullptr;
+  for (int level = levels_ - 1; level >= 0; --level) {
+    for (auto succ = next(node, level); succ && comp_(succ->value, value); succ = next(node, level))
+      node = succ;
+  }
+  return next(node, 0);
+}
+
+template<typename T, typename Comparator>
+std::pair<typename SkipList<T, Comparator>::iterator, bool> SkipList<T, Comparator>::insert(value_type value) {
+  std::array<Node *, max_level> update{};
+  find_predecessors(value, update);
+  auto found = next(update[0], 0);
+  if (found && !comp_(value, found->value))
+    return std::make_pair(iterator(this, found), false);
+  auto height = random_height();
+  auto node = make(std::move(value), height);
+  levels_ = std::max(levels_, height);
+  for (int level = 0; level < height; ++level) {
+    node->next()[level] = next(update[level], level);
+    next(update[level], level) = node;
+  }
+  node->prev = update[0];
+  if (node->next()[0])
+    node->next()[0]->prev = node;
+  else
+    tail_ = node;
+  ++size_;
+  return std::make_pair(iterator(this, node), true);
+}
+
+template<typename T, typename Comparator>
+void SkipList<T, Comparator>::unlink(Node *node, std::array<Node *, max_level> const &update) {
+  for (int level = 0; level < node->height; ++level)
+    next(update[level], level) = node->next()[level];
+  if (node->next()[0])
+    node->next()[0]->prev = node->prev;
+  else
+    tail_ = node->prev;
+  while (levels_ > 1 && !head_[levels_ - 1])
+    --levels_;
+  --size_;
+  destroy(node);
+}
+
+template<typename T, typename Comparator>
+typename SkipList<T, Comparator>::iterator SkipList<T, Comparator>::erase(const_iterator position) {
+  auto node = position.node_;
+  if (!node)
+    return end();
+  std::array<Node *, max_level> update{};
+  find_predecessors(node->value, update);
+  auto res = iterator(this, node->next()[0]);
+  unlink(node, update);
+  return res;
+}
+
+template<typename T, typename Comparator>
+std::size_t SkipList<T, Comparator>::erase(value_type const &value) {
+  std::array<Node *, max_level> update{};
+  find_predecessors(value, update);
+  auto node = next(update[0], 0);
+  if (!node || comp_(value, node->value))
+    return 0;
+  unlink(node, update);
+  return 1;
+}
+
+// The predecessors of first stay the predecessors of every following node until the range is
+// gone, so one search serves the whole range.
+template<typename T, typename Comparator>
+typename SkipList<T, Comparator>::iterator SkipList<T, Comparator>::erase(const_iterator first,
+                                                                          const_iterator last) {
+  if (first == last)
+    return iterator(this, last.node_);
+  std::array<Node *, max_level> update{};
+  find_predecessors(first.node_->value, update);
+  while (first != last) {
+    auto node = first.node_;
+    ++first;
+    unlink(node, update);
+  }
+  return iterator(this, last.node_);
+}
+
+template<typename T, typename Comparator>
+void SkipList<T, Comparator>::clear() {
+  for (auto node = head_[0]; node;) {
+    auto succ = node->next()[0];
+    destroy(node);
+    node = succ;
+  }
+  head_ = {};
+  tail_ = nullptr;
+  size_ = 0;
+  levels_ = 1;
+}
+
+template<typename T, typename Comparator>
+typename SkipList<T, Comparator>::const_iterator SkipList<T, Comparator>::find(value_type const &value) const {
+  auto node = lower_bound_node(value);
+  return const_iterator(this, node && !comp_(value, node->value) ? node : nullptr);
+}
+
+template<typename T, typename Comparator>
+typename SkipList<T, Comparator>::iterator SkipList<T, Comparator>::find(value_type const &value) {
+  auto node = lower_bound_node(value);
+  return iterator(this, node && !comp_(value, node->value) ? node : nullptr);
+}
+
+template<typename T, typename Comparator>
+typename SkipList<T, Comparator>::const_iterator
+SkipList<T, Comparator>::lower_bound(value_type const &value) const {
+  return const_iterator(this, lower_bound_node(value));
+}
+
+template<typename T, typename Comparator>
+typename SkipList<T, Comparator>::iterator SkipList<T, Comparator>::lower_bound(value_type const &value) {
+  return iterator(this, lower_bound_node(value));
+}
+
+template<typename T, typename Comparator>
+typename SkipList<T, Comparator>::const_iterator
+SkipList<T, Comparator>::upper_bound(value_type const &value) const {
+  auto node = lower_bound_node(value);
+  return const_iterator(this, node && !comp_(value, node->value) ? node->next()[0] : node);
+}
+
+template<typename T, typename Comparator>
+typename SkipList<T, Comparator>::iterator SkipList<T, Comparator>::upper_bound(value_type const &value) {
+  auto node = lower_bound_node(value);
+  return iterator(this, node && !comp_(value, node->value) ? node->next()[0] : node);
+}
+
+}
+#endif //ALGORITHMS_TREES_SKIP_LIST_SKIP_LIST_IPP_
@@ -0,0 +1,268 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <trees/skip_list/skip_list.h>
+#include <trees/skip_list/skip_list.ipp>
+#include <trees/skip_list/concurrent_skip_list.h>
+#include <trees/skip_list/concurrent_skip_list.ipp>
+#include <trees/avl/avl_tree.h>
+#include <trees/avl/avl_tree.ipp>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace trees::test {
+
+TEST(SkipList, random_insert_and_erase_matches_set) {
+  std::default_random_engine generator(83);
+  std::uniform_int_distribution<int> distribution(0, 5000);
+  SkipList<int> list;
+  std::set<int> expected;
+  for (int i = 0; i < 30000; ++i) {
+    auto number = distribution(generator);
+    if (i % 3 == 2) {
+      EXPECT_EQ(list.erase(number), expected.erase(number));
+    } else {
+      auto[itr, inserted] = list.insert(number);
+      EXPECT_EQ(inserted, expected.insert(number).second);
+      EXPECT_EQ(*itr, number);
+    }
+    ASSERT_EQ(list.size(), expected.size());
+  }
+  EXPECT_TRUE(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+  std::vector<int> reversed;
+  for (auto itr = list.end(); itr != list.begin();)
+    reversed.push_back(*--itr);
+  EXPECT_TRUE(std::equal(reversed.begin(), reversed.end(), expected.rbegin(), expected.rend()));
+  EXPECT_LE(list.levels(), SkipList<int>::max_level);
+  for (int key = -1; key <= 5001; key += 3) {
+    EXPECT_EQ(list.find(key) != list.end(), expected.count(key) == 1);
+    auto lower = list.lower_bound(key);
+    auto expected_lower = expected.lower_bound(key);
+    EXPECT_EQ(lower == list.end(), expected_lower == expected.end());
+    if (expected_lower != expected.end()) {
+      EXPECT_EQ(*lower, *expected_lower);
+    }
+    auto upper = list.upper_bound(key);
+    auto expected_upper = expected.upper_bound(key);
+    EXPECT_EQ(upper == list.end(), expected_upper == expected.end());
+    if (expected_upper != expected.end()) {
+      EXPECT_EQ(*upper, *expected_upper);
+    }
+  }
+}
+
+TEST(SkipList, erase_positions_and_ranges) {
+  SkipList<std::string> list;
+  std::set<std::string> expected;
+  for (int i = 0; i < 1000; ++i) {
+    list.insert(std::to_string(i));
+    expected.insert(std::to_string(i));
+  }
+  auto itr = list.erase(list.find("500"));
+  EXPECT_EQ(*itr, *expected.upper_bound("500"));
+  expected.erase("500");
+  itr = list.erase(list.lower_bound("2"), list.lower_bound("4"));
+  expected.erase(expected.lower_bound("2"), expected.lower_bound("4"));
+  EXPECT_EQ(*itr, "4");
+  EXPECT_TRUE(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+
+  SkipList<std::string> copy{list};
+  list.erase(list.begin(), list.end());
+  EXPECT_EQ(list.size(), 0);
+  EXPECT_EQ(list.begin(), list.end());
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), expected.begin(), expected.end()));
+  EXPECT_EQ(*--copy.end(), *expected.rbegin());
+  auto moved = std::move(copy);
+  EXPECT_EQ(moved.size(), expected.size());
+  EXPECT_TRUE(copy.empty());
+  copy.insert("x");
+  EXPECT_EQ(*copy.begin(), "x");
+}
+
+TEST(ConcurrentSkipList, random_insert_and_erase_matches_set) {
+  std::default_random_engine generator(89);
+  std::uniform_int_distribution<int> distribution(0, 3000);
+  ConcurrentSkipList<int> list;
+  std::set<int> expected;
+  for (int i = 0; i < 20000; ++i) {
+    auto number = distribution(generator);
+    if (i % 3 == 2)
+      EXPECT_EQ(list.erase(number), expected.erase(number));
+    else
+      EXPECT_EQ(list.insert(number), expected.insert(number).second);
+    ASSERT_EQ(list.size(), expected.size());
+  }
+  std::vector<int> visited;
+  list.for_each([&visited](int value) { visited.push_back(value); });
+  EXPECT_TRUE(std::equal(visited.begin(), visited.end(), expected.begin(), expected.end()));
+  for (int key = -1; key <= 3001; key += 7) {
+    EXPECT_EQ(list.contains(key), expected.count(key) == 1);
+    auto lower = list.lower_bound(key);
+    auto expected_lower = expected.lower_bound(key);
+    EXPECT_EQ(lower.has_value(), expected_lower != expected.end());
+    if (lower) {
+      EXPECT_EQ(*lower, *expected_lower);
+    }
+  }
+}
+
+TEST(ConcurrentSkipList, concurrent_writers_agree) {
+  ConcurrentSkipList<int> list;
+  constexpr int writers = 4;
+  constexpr int keys = 20000;
+  std::atomic<int> inserted{0};
+  std::atomic<int> erased{0};
+  std::vector<std::thread> threads;
+  for (int w = 0; w < writers; ++w) {
+    threads.emplace_back([&, w] {
+      std::default_random_engine generator(w);
+      std::uniform_int_distribution<int> distribution(0, keys - 1);
+      for (int i = 0; i < 50000; ++i) {
+        auto key = distribution(generator);
+        if (i % 2)
+          erased += static_cast<int>(list.erase(key));
+        else
+          inserted += list.insert(key);
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  std::size_t count = 0;
+  int previous = -1;
+  bool sorted = true;
+  list.for_each([&](int value) {
+    sorted = sorted && previous < value;
+    previous = value;
+    ++count;
+  });
+  EXPECT_TRUE(sorted);
+  EXPECT_EQ(count, list.size());
+  EXPECT_EQ(static_cast<std::size_t>(inserted - erased), list.size());
+}
+
+TEST(ConcurrentSkipList, readers_see_stable_keys_during_writes) {
+  ConcurrentSkipList<std::string> list;
+  for (int i = 0; i < 2000; i += 2)
+    list.insert(std::to_string(i));
+  std::atomic<bool> done{false};
+  std::atomic<std::size_t> misses{0};
+  std::vector<std::thread> threads;
+  for (int r = 0; r < 2; ++r) {
+    threads.emplace_back([&list, &done, &misses, r] {
+      std::default_random_engine generator(r);
+      std::uniform_int_distribution<int> distribution(0, 999);
+      while (!done.load()) {
+        auto key = std::to_string(2 * distribution(generator));
+        if (list.find(key) != key)
+          ++misses;
+      }
+    });
+  }
+  for (int w = 0; w < 2; ++w) {
+    threads.emplace_back([&list, w] {
+      std::default_random_engine generator(10 + w);
+      std::uniform_int_distribution<int> distribution(0, 999);
+      for (int i = 0; i < 20000; ++i) {
+        auto key = std::to_string(2 * distribution(generator) + 1);
+        if (i % 2)
+          list.erase(key);
+        else
+          list.insert(key);
+      }
+    });
+  }
+  threads[2].join();
+  threads[3].join();
+  done = true;
+  threads[0].join();
+  threads[1].join();
+  EXPECT_EQ(misses.load(), 0);
+}
+
+template<typename Set, typename Insert, typename Find>
+std::size_t mixed_throughput(Set &set, unsigned threads, Insert insert, Find find) {
+  std::atomic<bool> done{false};
+  std::atomic<std::size_t> operations{0};
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      std::default_random_engine generator(t);
+      std::uniform_int_distribution<int> distribution(0, 1 << 20);
+      std::size_t count = 0;
+      while (!done.load(std::memory_order_relaxed)) {
+        auto key = distribution(generator);
+        // One insert for every four lookups.
+        if (count % 5 == 0)
+          insert(set, key);
+        else
+          find(set, key);
+        ++count;
+      }
+      operations += count;
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  done = true;
+  for (auto &worker : workers)
+    worker.join();
+  return operations.load() * 5;
+}
+
+TEST(ConcurrentSkipList, benchmark_mixed_scaling_vs_mutex) {
+  auto max_threads = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned threads = 1;; threads = std::min(2 * threads, max_threads)) {
+    ConcurrentSkipList<int> list;
+    avl::AVLTree<int> locked_tree;
+    std::mutex mutex;
+    auto concurrent = mixed_throughput(
+        list, threads,
+        [](auto &set, int key) { set.insert(key); },
+        [](auto &set, int key) { return set.contains(key); });
+    auto locked = mixed_throughput(
+        locked_tree, threads,
+        [&mutex](auto &tree, int key) {
+          std::lock_guard lock{mutex};
+          tree.insert(key);
+        },
+        [&mutex](auto &tree, int key) {
+          std::lock_guard lock{mutex};
+          return tree.find(key) != tree.end();
+        });
+    std::cout << threads << " threads: ConcurrentSkipList " << concurrent << " ops/s, mutex AVLTree " << locked
+              << " ops/s" << std::endl;
+    if (threads == max_threads)
+      break;
+  }
+}
+
+}
@@ -0,0 +1,97 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_TREE_IMAGE_H_
+#define ALGORITHMS_TREES_TREE_IMAGE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <type_traits>
+
+namespace trees {
+
+// An image is this header followed by the elements in order as raw bytes. Shape and balance are
+// not stored: a sorted sequence rebuilds into a balanced tree in linear time, which is cheaper
+// than reading them. Images only travel between machines sharing the element layout and byte
+// order, which element_size and magic partly check.
+struct TreeImageHeader {
+  static constexpr std::uint64_t expected_magic = 0x31474d4945455254; // "TREEIMG1" in little endian
+  static constexpr std::uint32_t current_version = 1;
+
+  std::uint64_t magic;
+  std::uint32_t version;
+  std::uint32_t element_size;
+  std::uint64_t count;
+  // Pads the header to a cache line so the elements after it are aligned for any key type.
+  std::uint8_t reserved[40];
+};
+
+static_assert(sizeof(TreeImageHeader) == 64);
+
+// Writes the elements of range, in iteration order, to path with one sequential write. Throws
+// std::runtime_error when the file cannot be written.
+template<typename Range>
+void save_image(Range const &range, std::string const &path);
+
+// Read-only memory mapping of an image. Lookups binary search the mapped elements directly, and
+// load copies them into a tree without parsing. Throws std::runtime_error for unreadable or
+// malformed files.
+template<typename T, typename Comparator = std::less<T>>
+class MappedImage {
+  static_assert(std::is_trivially_copyable_v<T>, "images hold raw element bytes");
+  static_assert(alignof(T) <= sizeof(TreeImageHeader), "elements must be aligned after the header");
+
+ public:
+  explicit MappedImage(std::string const &path, Comparator comp = Comparator());
+  MappedImage(MappedImage &&src) noexcept;
+  MappedImage(MappedImage const &) = delete;
+  MappedImage &operator=(MappedImage const &) = delete;
+  ~MappedImage();
+
+  [[nodiscard]] std::span<T const> elements() const;
+  [[nodiscard]] inline std::size_t size() const { return elements().size(); }
+
+  // Both return nullptr when there is no such element.
+  [[nodiscard]] T const *find(T const &value) const;
+  [[nodiscard]] T const *lower_bound(T const &value) const;
+
+  // Replaces the contents of tree with the elements, through its linear assign_sorted.
+  template<typename Tree>
+  void load(Tree &tree) const;
+
+ private:
+  Comparator comp_;
+  void *address_;
+  std::size_t length_;
+};
+
+// Shorthand for mapping path and loading it into tree.
+template<typename Tree>
+void load_image(Tree &tree, std::string const &path);
+
+}
+#endif //ALGORITHMS_TREES_TREE_IMAGE_H_
@@ -0,0 +1,139 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_TREES_TREE_IMAGE_IPP_
+#define ALGORITHMS_TREES_TREE_IMAGE_IPP_
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <trees/tree_image.h>
+
+namespace trees {
+
+template<typename Range>
+void save_image(Range const &range, std::string const &path) {
+  using value_type = typename Range::value_type;
+  static_assert(std::is_trivially_copyable_v<value_type>, "images hold raw element bytes");
+  TreeImageHeader header{TreeImageHeader::expected_magic, TreeImageHeader::current_version,
+                         sizeof(value_type), range.size(), {}};
+  std::vector<std::byte> buffer(sizeof(header) + range.size() * sizeof(value_type));
+  std::memcpy(buffer.data(), &header, sizeof(header));
+  auto out = buffer.data() + sizeof(header);
+  for (auto const &value : range) {
+    std::memcpy(out, &value, sizeof(value_type));
+    out += sizeof(value_type);
+  }
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<char const *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+  file.close();
+  if (!file)
+    throw std::runtime_error("cannot write tree image " + path);
+}
+
+template<typename T, typename Comparator>
+MappedImage<T, Comparator>::MappedImage(std::string const &path, Comparator comp)
+    : comp_{comp}, address_{nullptr}, length_{0} {
+  auto fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error("cannot open tree image " + path);
+  struct stat status{};
+  if (::fstat(fd, &status) == 0 && static_cast<std::size_t>(status.st_size) >= sizeof(TreeImageHeader)) {
+    length_ = static_cast<std::size_t>(status.st_size);
+    address_ = ::mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  ::close(fd);
+  if (!address_ || address_ == MAP_FAILED) {
+    address_ = nullptr;
+    throw std::runtime_error("cannot map tree image " + path);
+  }
+  TreeImageHeader header{};
+  std::memcpy(&header, address_, sizeof(header));
+  if (header.magic != TreeImageHeader::expected_magic
+      || header.version != TreeImageHeader::current_version
+      || header.element_size != sizeof(T)
+      || header.count != (length_ - sizeof(header)) / sizeof(T)
+      || (length_ - sizeof(header)) % sizeof(T) != 0) {
+    ::munmap(address_, length_);
+    throw std::runtime_error("malformed tree image " + path);
+  }
+}
+
+template<typename T, typename Comparator>
+MappedImage<T, Comparator>::MappedImage(MappedImage &&src) noexcept
+    : comp_{src.comp_}, address_{src.address_}, length_{src.length_} {
+  src.address_ = nullptr;
+  src.length_ = 0;
+}
+
+template<typename T, typename Comparator>
+MappedImage<T, Comparator>::~MappedImage() {
+  if (address_)
+    ::munmap(address_, length_);
+}
+
+template<typename T, typename Comparator>
+std::span<T const> MappedImage<T, Comparator>::elements() const {
+  if (!address_)
+    return {};
+  auto first = reinterpret_cast<T const *>(static_cast<std::byte const *>(address_) + sizeof(TreeImageHeader));
+  return std::span<T const>(first, (length_ - sizeof(TreeImageHeader)) / sizeof(T));
+}
+
+template<typename T, typename Comparator>
+T const *MappedImage<T, Comparator>::lower_bound(T const &value) const {
+  auto keys = elements();
+  auto res = std::lower_bound(keys.begin(), keys.end(), value, comp_);
+  return res == keys.end() ? nullptr : &*res;
+}
+
+template<typename T, typename Comparator>
+T const *MappedImage<T, Comparator>::find(T const &value) const {
+  auto res = lower_bound(value);
+  return res && !comp_(value, *res) ? res : nullptr;
+}
+
+template<typename T, typename Comparator>
+template<typename Tree>
+void MappedImage<T, Comparator>::load(Tree &tree) const {
+  auto keys = elements();
+  if (address_)
+    ::madvise(address_, length_, MADV_SEQUENTIAL);
+  tree.assign_sorted(keys.begin(), keys.end());
+}
+
+template<typename Tree>
+void load_image(Tree &tree, std::string const &path) {
+  MappedImage<typename Tree::value_type> image(path);
+  image.load(tree);
+}
+
+}
+#endif //ALGORITHMS_TREES_TREE_IMAGE_IPP_
@@ -0,0 +1,163 @@
+/*
+MIT License
+
+Copyright (c) 2020 Guilherme Simoes Schlinker
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <trees/tree_image.h>
+#include <trees/tree_image.ipp>
+#include <trees/avl/avl_tree.h>
+#include <trees/avl/avl_tree.ipp>
+#include <trees/rb/rb_tree.h>
+#include <trees/rb/rb_tree.ipp>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace trees::test {
+
+namespace {
+
+std::string image_path(std::string const &name) {
+  return (std::filesystem::temp_directory_path() / ("trees_" + name + ".img")).string();
+}
+
+std::set<unsigned int> random_set(std::size_t size, unsigned int seed) {
+  std::default_random_engine generator(seed);
+  std::uniform_int_distribution<unsigned int> distribution;
+  std::set<unsigned int> res;
+  while (res.size() < size)
+    res.insert(distribution(generator));
+  return res;
+}
+
+}
+
+TEST(TreeImage, round_trip_into_every_tree) {
+  auto expected = random_set(5000, 59);
+  avl::AVLTree<unsigned int> source;
+  for (auto number : expected)
+    source.insert(number);
+  auto path = image_path("round_trip");
+  save_image(source, path);
+
+  avl::AVLTree<unsigned int> avl_tree;
+  avl_tree.insert(7);
+  load_image(avl_tree, path);
+  EXPECT_TRUE(std::equal(avl_tree.begin(), avl_tree.end(), expected.begin(), expected.end()));
+  EXPECT_EQ(avl_tree.size(), expected.size());
+  for (auto itr = avl_tree.begin(); itr != avl_tree.end(); ++itr)
+    ASSERT_LE(std::abs(avl_tree.balance(itr)), 1);
+
+  MappedImage<unsigned int> image(path);
+  BST<unsigned int> bst;
+  image.load(bst);
+  EXPECT_TRUE(std::equal(bst.begin(), bst.end(), expected.begin(), expected.end()));
+  EXPECT_EQ(bst.height(), static_cast<std::size_t>(std::log2(expected.size())));
+
+  rb::RBTree<unsigned int> rb_tree;
+  image.load(rb_tree);
+  EXPECT_TRUE(std::equal(rb_tree.begin(), rb_tree.end(), expected.begin(), expected.end()));
+  for (auto number : expected)
+    if (number % 2)
+      rb_tree.erase(number);
+  for (auto number : random_set(2000, 61))
+    rb_tree.insert(number);
+  EXPECT_LE(rb_tree.height(), 2 * std::log2(rb_tree.size() + 1));
+
+  avl::SlabAVLTree<unsigned int> slab_tree;
+  image.load(slab_tree);
+  EXPECT_EQ(slab_tree.size(), expected.size());
+  std::filesystem::remove(path);
+}
+
+TEST(TreeImage, lookups_read_the_mapping) {
+  auto expected = random_set(3000, 67);
+  auto path = image_path("lookups");
+  save_image(expected, path);
+  MappedImage<unsigned int> image(path);
+  ASSERT_EQ(image.size(), expected.size());
+  EXPECT_TRUE(std::equal(image.elements().begin(), image.elements().end(), expected.begin(), expected.end()));
+  for (auto number : random_set(500, 71)) {
+    auto found = image.find(number);
+    EXPECT_EQ(found != nullptr, expected.count(number) == 1);
+    auto bound = image.lower_bound(number);
+    auto expected_bound = expected.lower_bound(number);
+    if (expected_bound == expected.end())
+      EXPECT_EQ(bound, nullptr);
+    else
+      EXPECT_EQ(*bound, *expected_bound);
+  }
+  EXPECT_EQ(*image.find(*expected.begin()), *expected.begin());
+  std::filesystem::remove(path);
+}
+
+TEST(TreeImage, empty_and_malformed_images) {
+  auto path = image_path("empty");
+  save_image(avl::AVLTree<unsigned int>{}, path);
+  avl::AVLTree<unsigned int> tree;
+  tree.insert(3);
+  load_image(tree, path);
+  EXPECT_EQ(tree.size(), 0);
+  EXPECT_EQ(tree.begin(), tree.end());
+
+  EXPECT_THROW(MappedImage<unsigned long>{path}, std::runtime_error);
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    file.write("xy", 2);
+  }
+  EXPECT_THROW(MappedImage<unsigned int>{path}, std::runtime_error);
+  std::filesystem::remove(path);
+  EXPECT_THROW(MappedImage<unsigned int>{path}, std::runtime_error);
+}
+
+TEST(TreeImage, benchmark_load_against_insert) {
+  auto expected = random_set(1 << 19, 73);
+  std::vector<unsigned int> numbers(expected.begin(), expected.end());
+  std::shuffle(numbers.begin(), numbers.end(), std::default_random_engine(79));
+  auto path = image_path("benchmark");
+  save_image(expected, path);
+
+  auto start = std::chrono::high_resolution_clock::now();
+  avl::AVLTree<unsigned int> inserted;
+  for (auto number : numbers)
+    inserted.insert(number);
+  auto finish = std::chrono::high_resolution_clock::now();
+  auto insert_us = std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+
+  start = std::chrono::high_resolution_clock::now();
+  avl::AVLTree<unsigned int> loaded;
+  load_image(loaded, path);
+  finish = std::chrono::high_resolution_clock::now();
+  auto load_us = std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+
+  EXPECT_TRUE(std::equal(loaded.begin(), loaded.end(), inserted.begin(), inserted.end()));
+  std::cout << "rebuild by insert: " << insert_us << "us load image: " << load_us << "us" << std::endl;
+  std::filesystem::remove(path);
+}
+
+}